@@ -35,6 +35,7 @@
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_map.h"
 #include "core/variant/dictionary.h"
@@ -458,12 +459,28 @@ int Image::get_mipmap_count() const {
 	}
 }
 
+// Images with fewer destination pixels than this are always processed on the calling thread.
+static constexpr uint64_t IMAGE_PARALLEL_MIN_PIXELS = 256 * 256;
+// Minimum amount of rows handed to a single worker task.
+static constexpr uint32_t IMAGE_PARALLEL_MIN_ROWS = 16;
+
+// Calls `p_func(from, to)` over row ranges covering `[0, p_rows)`. Large images are split across
+// the WorkerThreadPool; every row is computed by the same code either way, so results are identical.
+template <typename F>
+static void _process_rows(uint32_t p_rows, uint64_t p_pixels, const F &p_func) {
+	if (p_pixels < IMAGE_PARALLEL_MIN_PIXELS) {
+		p_func(0, p_rows);
+		return;
+	}
+	WorkerThreadPool::process_ranges(p_rows, IMAGE_PARALLEL_MIN_ROWS, p_func);
+}
+
 //using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
-static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+static void _convert_rows(int p_width, const uint8_t *p_src, uint8_t *p_dst, int p_from_row, int p_to_row) {
 	constexpr uint32_t max_bytes = MAX(read_bytes, write_bytes);
 
-	for (int y = 0; y < p_height; y++) {
+	for (int y = p_from_row; y < p_to_row; y++) {
 		for (int x = 0; x < p_width; x++) {
 			const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
 			uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
@@ -501,12 +518,19 @@ static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p
 	}
 }
 
+template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
+static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+	_process_rows(p_height, uint64_t(p_width) * p_height, [&](uint32_t p_from, uint32_t p_to) {
+		_convert_rows<read_bytes, read_alpha, write_bytes, write_alpha, read_gray, write_gray>(p_width, p_src, p_dst, p_from, p_to);
+	});
+}
+
 template <typename T, uint32_t read_channels, uint32_t write_channels, T def_zero, T def_one>
-static void _convert_fast(int p_width, int p_height, const T *p_src, T *p_dst) {
-	uint32_t dst_count = 0;
-	uint32_t src_count = 0;
+static void _convert_fast_rows(int p_width, const T *p_src, T *p_dst, int p_from_row, int p_to_row) {
+	uint32_t dst_count = p_from_row * p_width * write_channels;
+	uint32_t src_count = p_from_row * p_width * read_channels;
 
-	const int resolution = p_width * p_height;
+	const int resolution = (p_to_row - p_from_row) * p_width;
 
 	for (int i = 0; i < resolution; i++) {
 		memcpy(p_dst + dst_count, p_src + src_count, MIN(read_channels, write_channels) * sizeof(T));
@@ -521,6 +545,13 @@ static void _convert_fast(int p_width, int p_height, const T *p_src, T *p_dst) {
 	}
 }
 
+template <typename T, uint32_t read_channels, uint32_t write_channels, T def_zero, T def_one>
+static void _convert_fast(int p_width, int p_height, const T *p_src, T *p_dst) {
+	_process_rows(p_height, uint64_t(p_width) * p_height, [&](uint32_t p_from, uint32_t p_to) {
+		_convert_fast_rows<T, read_channels, write_channels, def_zero, def_one>(p_width, p_src, p_dst, p_from, p_to);
+	});
+}
+
 static bool _are_formats_compatible(Image::Format p_format0, Image::Format p_format1) {
 	if (p_format0 <= Image::FORMAT_RGBA8 && p_format1 <= Image::FORMAT_RGBA8) {
 		return true;
@@ -777,7 +808,7 @@ static double _bicubic_interp_kernel(double x) {
 }
 
 template <int CC, typename T>
-static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 	// get source image size
 	int width = p_src_width;
 	int height = p_src_height;
@@ -792,7 +823,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
+	for (uint32_t y = p_from_row; y < p_to_row; y++) {
 		// Y coordinates
 		oy = (double)y * yfac - 0.5f;
 		oy1 = (int)oy;
@@ -864,7 +895,14 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 }
 
 template <int CC, typename T>
-static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_cubic_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
+}
+
+template <int CC, typename T>
+static void _scale_bilinear_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 	enum {
 		FRAC_BITS = 8,
 		FRAC_LEN = (1 << FRAC_BITS),
@@ -872,7 +910,7 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 		FRAC_MASK = FRAC_LEN - 1
 	};
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 		// Add 0.5 in order to interpolate based on pixel center
 		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
 		// Calculate nearest src pixel center above current, and truncate to get y index
@@ -954,8 +992,15 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 }
 
 template <int CC, typename T>
-static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_bilinear_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
+}
+
+template <int CC, typename T>
+static void _scale_nearest_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 		uint32_t src_yofs = i * p_src_height / p_dst_height;
 		uint32_t y_ofs = src_yofs * p_src_width * CC;
 
@@ -974,6 +1019,13 @@ static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict
 	}
 }
 
+template <int CC, typename T>
+static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_nearest_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
+}
+
 #define LANCZOS_TYPE 3
 
 static float _lanczos(float p_x) {
@@ -1765,15 +1817,14 @@ bool Image::_can_modify(Format p_format) const {
 template <typename Component, int CC, bool renormalize,
 		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
 		void (*renormalize_func)(Component *)>
-static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+static void _generate_po2_mipmap_rows(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height, uint32_t p_from_row, uint32_t p_to_row) {
 	//fast power of 2 mipmap generation
 	uint32_t dst_w = MAX(p_width >> 1, 1u);
-	uint32_t dst_h = MAX(p_height >> 1, 1u);
 
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 		const Component *rup_ptr = &p_src[i * 2 * down_step];
 		const Component *rdown_ptr = rup_ptr + down_step;
 		Component *dst_ptr = &p_dst[i * dst_w * CC];
@@ -1796,6 +1847,18 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	}
 }
 
+template <typename Component, int CC, bool renormalize,
+		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
+		void (*renormalize_func)(Component *)>
+static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+	uint32_t dst_w = MAX(p_width >> 1, 1u);
+	uint32_t dst_h = MAX(p_height >> 1, 1u);
+
+	_process_rows(dst_h, uint64_t(dst_w) * dst_h, [&](uint32_t p_from, uint32_t p_to) {
+		_generate_po2_mipmap_rows<Component, CC, renormalize, average_func, renormalize_func>(p_src, p_dst, p_width, p_height, p_from, p_to);
+	});
+}
+
 void Image::shrink_x2() {
 	ERR_FAIL_COND(data.is_empty());
 
@@ -178,7 +178,7 @@ void RotatedFileLogger::rotate_file() {
 	file->detach_from_objectdb(); // Note: This FileAccess instance will exist longer than ObjectDB, therefore can't be registered in ObjectDB.
 }
 
-RotatedFileLogger::RotatedFileLogger(const String &p_base_path, int p_max_files) :
+RotatedFileLogger::RotatedFileLogger(const String &p_base_path, int p_max_files, bool p_threaded) :
 		base_path(p_base_path.simplify_path()),
 		max_files(p_max_files > 0 ? p_max_files : 1) {
 	rotate_file();
@@ -188,6 +188,110 @@ RotatedFileLogger::RotatedFileLogger(const String &p_base_path, int p_max_files)
 	strip_ansi_regex->detach_from_objectdb(); // Note: This RegEx instance will exist longer than ObjectDB, therefore can't be registered in ObjectDB.
 	strip_ansi_regex->compile("\u001b\\[((?:\\d|;)*)([a-zA-Z])");
 #endif // MODULE_REGEX_ENABLED
+
+#ifdef THREADS_ENABLED
+	threaded = p_threaded;
+	if (threaded) {
+		thread.start(&RotatedFileLogger::_thread_func, this);
+	}
+#endif
+}
+
+RotatedFileLogger::~RotatedFileLogger() {
+	if (threaded) {
+		exit_thread.set();
+		pending_semaphore.post();
+		thread.wait_to_finish();
+		_write_pending(true);
+	}
+}
+
+void RotatedFileLogger::_store(const char *p_buf, int p_len) {
+#ifdef MODULE_REGEX_ENABLED
+	// Strip ANSI escape codes (such as those inserted by `print_rich()`)
+	// before writing to file, as text editors cannot display those
+	// correctly.
+	file->store_string(strip_ansi_regex->sub(String::utf8(p_buf, p_len), "", true));
+#else
+	file->store_buffer((const uint8_t *)p_buf, p_len);
+#endif // MODULE_REGEX_ENABLED
+}
+
+void RotatedFileLogger::_thread_func(void *p_user) {
+	RotatedFileLogger *logger = static_cast<RotatedFileLogger *>(p_user);
+	while (!logger->exit_thread.is_set()) {
+		logger->pending_semaphore.wait();
+		logger->_write_pending(false);
+	}
+}
+
+void RotatedFileLogger::_write_pending(bool p_force_flush) {
+	// The file lock is taken first so messages are written in the order they were queued,
+	// even when a flush from another thread races with the background thread.
+	MutexLock file_lock(file_mutex);
+
+	uint64_t dropped = 0;
+	bool should_flush = p_force_flush;
+	{
+		MutexLock pending_lock(pending_mutex);
+		pending_buffer = 1 - pending_buffer;
+		dropped = dropped_messages;
+		dropped_messages = 0;
+		should_flush = should_flush || pending_flush;
+		pending_flush = false;
+	}
+
+	// Only the thread holding the file lock touches the buffer that isn't pending.
+	LocalVector<char> &writing = buffers[1 - pending_buffer];
+	if (file.is_valid()) {
+		if (dropped > 0) {
+			file->store_string(vformat("[%d log messages dropped, logging faster than the log file could be written]\n", dropped));
+		}
+		if (!writing.is_empty()) {
+			_store(writing.ptr(), writing.size());
+		}
+		if (should_flush) {
+			file->flush();
+		}
+	}
+	writing.clear();
+}
+
+bool RotatedFileLogger::_try_lock_for_crash(Mutex &p_mutex) {
+	// Give a thread that is writing or queuing messages time to finish, but don't wait forever
+	// in case the lock is held by the thread that crashed.
+	for (int i = 0; i < 100; i++) {
+		if (p_mutex.try_lock()) {
+			return true;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return false;
+}
+
+void RotatedFileLogger::flush() {
+	// Called from crash handlers, possibly inside a signal handler: never block indefinitely on a lock
+	// held by the crashed thread and don't allocate. The queue is written as is, without stripping ANSI codes.
+	if (!_try_lock_for_crash(file_mutex)) {
+		return;
+	}
+
+	if (threaded) {
+		if (_try_lock_for_crash(pending_mutex)) {
+			LocalVector<char> &pending = buffers[pending_buffer];
+			if (file.is_valid() && !pending.is_empty()) {
+				file->store_buffer((const uint8_t *)pending.ptr(), pending.size());
+			}
+			pending.clear();
+			pending_mutex.unlock();
+		}
+	}
+
+	if (file.is_valid()) {
+		file->flush();
+	}
+
+	file_mutex.unlock();
 }
 
 void RotatedFileLogger::logv(const char *p_format, va_list p_list, bool p_err) {
@@ -207,28 +311,46 @@ void RotatedFileLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 			vsnprintf(buf, len + 1, p_format, list_copy);
 		}
 		va_end(list_copy);
-
-#ifdef MODULE_REGEX_ENABLED
-		// Strip ANSI escape codes (such as those inserted by `print_rich()`)
-		// before writing to file, as text editors cannot display those
-		// correctly.
-		file->store_string(strip_ansi_regex->sub(String::utf8(buf), "", true));
-#else
-		file->store_buffer((uint8_t *)buf, len);
-#endif // MODULE_REGEX_ENABLED
-
-		if (len >= static_buf_size) {
-			Memory::free_static(buf);
+		len = MAX(len, 0);
+
+		if (threaded) {
+			{
+				MutexLock pending_lock(pending_mutex);
+				LocalVector<char> &pending = buffers[pending_buffer];
+				if (pending.size() + len > MAX_PENDING_BYTES) {
+					dropped_messages++;
+				} else {
+					const uint32_t ofs = pending.size();
+					pending.resize(ofs + len);
+					memcpy(pending.ptr() + ofs, buf, len);
+				}
+				if (p_err || _flush_stdout_on_print) {
+					pending_flush = true;
+				}
+			}
+			pending_semaphore.post();
+		} else {
+			MutexLock file_lock(file_mutex);
+			_store(buf, len);
+
+			if (p_err || _flush_stdout_on_print) {
+				// Don't always flush when printing stdout to avoid performance
+				// issues when `print()` is spammed in release builds.
+				file->flush();
+			}
 		}
 
-		if (p_err || _flush_stdout_on_print) {
-			// Don't always flush when printing stdout to avoid performance
-			// issues when `print()` is spammed in release builds.
-			file->flush();
+		if (buf != static_buf) {
+			Memory::free_static(buf);
 		}
 	}
 }
 
+void StdLogger::flush() {
+	fflush(stdout);
+	fflush(stderr);
+}
+
 void StdLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 	if (!should_log(p_err)) {
 		return;
@@ -273,6 +395,12 @@ void CompositeLogger::log_error(const char *p_function, const char *p_file, int
 	}
 }
 
+void CompositeLogger::flush() {
+	for (int i = 0; i < loggers.size(); ++i) {
+		loggers[i]->flush();
+	}
+}
+
 void CompositeLogger::add_logger(Logger *p_logger) {
 	loggers.push_back(p_logger);
 }
@@ -32,7 +32,12 @@
 #define LOGGER_H
 
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/vector.h"
 #include "modules/modules_enabled.gen.h" // For regex.
 #ifdef MODULE_REGEX_ENABLED
@@ -63,6 +68,9 @@ public:
 	void logf(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 	void logf_error(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 
+	// Writes out anything the logger may still be holding in memory.
+	virtual void flush() {}
+
 	virtual ~Logger() {}
 };
 
@@ -72,6 +80,7 @@ public:
 class StdLogger : public Logger {
 public:
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) override _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void flush() override;
 	virtual ~StdLogger() {}
 };
 
@@ -80,24 +89,48 @@ public:
  * of it with timestamp appended to the file name. Maximum number of backups is configurable.
  * When maximum is reached, the oldest backups are erased. With the maximum being equal to 1,
  * it acts as a simple file logger.
+ * When threaded, messages are queued in a bounded buffer and written by a background thread,
+ * so logging threads never wait on the file. Messages that don't fit are dropped and counted.
  */
 class RotatedFileLogger : public Logger {
 	String base_path;
 	int max_files;
 
 	Ref<FileAccess> file;
+	Mutex file_mutex;
 
 	void clear_old_backups();
 	void rotate_file();
+	void _store(const char *p_buf, int p_len);
 
 #ifdef MODULE_REGEX_ENABLED
 	Ref<RegEx> strip_ansi_regex;
 #endif // MODULE_REGEX_ENABLED
 
+	static const uint32_t MAX_PENDING_BYTES = 1 << 20;
+
+	bool threaded = false;
+	Thread thread;
+	Semaphore pending_semaphore;
+	Mutex pending_mutex;
+	// Messages are queued in one buffer while the other one is written, they are swapped under pending_mutex.
+	LocalVector<char> buffers[2];
+	uint32_t pending_buffer = 0;
+	uint64_t dropped_messages = 0;
+	bool pending_flush = false;
+	SafeFlag exit_thread;
+
+	static void _thread_func(void *p_user);
+	void _write_pending(bool p_force_flush);
+	static bool _try_lock_for_crash(Mutex &p_mutex);
+
 public:
-	explicit RotatedFileLogger(const String &p_base_path, int p_max_files = 10);
+	explicit RotatedFileLogger(const String &p_base_path, int p_max_files = 10, bool p_threaded = false);
 
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) override _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void flush() override;
+
+	virtual ~RotatedFileLogger();
 };
 
 class CompositeLogger : public Logger {
@@ -108,6 +141,7 @@ public:
 
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) override _PRINTF_FORMAT_ATTRIBUTE_2_0;
 	virtual void log_error(const char *p_function, const char *p_file, int p_line, const char *p_code, const char *p_rationale, bool p_editor_notify, ErrorType p_type = ERR_ERROR) override;
+	virtual void flush() override;
 
 	void add_logger(Logger *p_logger);
 
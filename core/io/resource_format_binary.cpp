@@ -100,6 +100,13 @@ enum {
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
 };
 
+bool ResourceLoaderBinary::_is_array_length_valid(uint32_t p_len, size_t p_element_size) const {
+	// Reject lengths that can't possibly fit in what remains of the file, so a corrupt
+	// header doesn't make us allocate (and then fail to fill) a huge buffer.
+	const uint64_t remaining = f->get_length() - f->get_position();
+	return (uint64_t)p_len * p_element_size <= remaining;
+}
+
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	uint32_t extra = 4 - (p_len % 4);
 	if (extra < 4) {
@@ -109,6 +116,9 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
+// Number of components converted at once when the stored precision differs from `real_t`.
+static constexpr size_t READ_REALS_CHUNK_SIZE = 256;
+
 static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	if (f->real_is_double) {
 		if constexpr (sizeof(real_t) == 8) {
@@ -124,8 +134,20 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 #endif
 		} else if constexpr (sizeof(real_t) == 4) {
 			// May be slower, but this is for compatibility. Eventually the data should be converted.
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_double();
+			if (f->is_big_endian()) {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = f->get_double();
+				}
+			} else {
+				// Convert in chunks rather than going through the file one component at a time.
+				uint8_t buf[READ_REALS_CHUNK_SIZE * sizeof(double)];
+				for (size_t i = 0; i < count; i += READ_REALS_CHUNK_SIZE) {
+					const size_t chunk = MIN(count - i, (size_t)READ_REALS_CHUNK_SIZE);
+					f->get_buffer(buf, chunk * sizeof(double));
+					for (size_t j = 0; j < chunk; j++) {
+						dst[i + j] = decode_double(&buf[j * sizeof(double)]);
+					}
+				}
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -143,8 +165,19 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 			}
 #endif
 		} else if constexpr (sizeof(real_t) == 8) {
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_float();
+			if (f->is_big_endian()) {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = f->get_float();
+				}
+			} else {
+				uint8_t buf[READ_REALS_CHUNK_SIZE * sizeof(float)];
+				for (size_t i = 0; i < count; i += READ_REALS_CHUNK_SIZE) {
+					const size_t chunk = MIN(count - i, (size_t)READ_REALS_CHUNK_SIZE);
+					f->get_buffer(buf, chunk * sizeof(float));
+					for (size_t j = 0; j < chunk; j++) {
+						dst[i + j] = decode_float(&buf[j * sizeof(float)]);
+					}
+				}
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -510,6 +543,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_BYTE_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, sizeof(uint8_t)), ERR_FILE_CORRUPT);
 
 			Vector<uint8_t> array;
 			array.resize(len);
@@ -522,6 +556,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_INT32_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, sizeof(int32_t)), ERR_FILE_CORRUPT);
 
 			Vector<int32_t> array;
 			array.resize(len);
@@ -541,6 +576,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_INT64_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, sizeof(int64_t)), ERR_FILE_CORRUPT);
 
 			Vector<int64_t> array;
 			array.resize(len);
@@ -560,6 +596,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_FLOAT32_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, sizeof(float)), ERR_FILE_CORRUPT);
 
 			Vector<float> array;
 			array.resize(len);
@@ -579,6 +616,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_FLOAT64_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, sizeof(double)), ERR_FILE_CORRUPT);
 
 			Vector<double> array;
 			array.resize(len);
@@ -598,6 +636,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_STRING_ARRAY: {
 			uint32_t len = f->get_32();
+			// Every string is stored with at least its 32-bit length.
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, sizeof(uint32_t)), ERR_FILE_CORRUPT);
 			Vector<String> array;
 			array.resize(len);
 			String *w = array.ptrw();
@@ -610,6 +650,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR2_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, 2 * (f->real_is_double ? sizeof(double) : sizeof(float))), ERR_FILE_CORRUPT);
 
 			Vector<Vector2> array;
 			array.resize(len);
@@ -623,6 +664,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR3_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, 3 * (f->real_is_double ? sizeof(double) : sizeof(float))), ERR_FILE_CORRUPT);
 
 			Vector<Vector3> array;
 			array.resize(len);
@@ -636,6 +678,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_COLOR_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, 4 * sizeof(float)), ERR_FILE_CORRUPT);
 
 			Vector<Color> array;
 			array.resize(len);
@@ -657,6 +700,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR4_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!_is_array_length_valid(len, 4 * (f->real_is_double ? sizeof(double) : sizeof(float))), ERR_FILE_CORRUPT);
 
 			Vector<Vector4> array;
 			array.resize(len);
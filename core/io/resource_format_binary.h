@@ -80,6 +80,7 @@ class ResourceLoaderBinary {
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
+	bool _is_array_length_valid(uint32_t p_len, size_t p_element_size) const;
 
 	HashMap<String, String> remaps;
 	Error error = OK;
@@ -50,101 +50,119 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 	ERR_FAIL_COND_MSG(p_id < 0, vformat("Can't add a point with negative id: %d.", p_id));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't add a point with weight scale less than 0.0: %f.", p_weight_scale));
 
-	Point *found_pt;
-	bool p_exists = points.lookup(p_id, found_pt);
+	uint32_t slot = 0;
+	bool p_exists = points.lookup(p_id, slot);
 
 	if (!p_exists) {
-		Point *pt = memnew(Point);
-		pt->id = p_id;
-		pt->pos = p_pos;
-		pt->weight_scale = p_weight_scale;
-		pt->prev_point = nullptr;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
-		pt->enabled = true;
-		points.set(p_id, pt);
-	} else {
-		found_pt->pos = p_pos;
-		found_pt->weight_scale = p_weight_scale;
+		if (!free_slots.is_empty()) {
+			slot = free_slots[free_slots.size() - 1];
+			free_slots.remove_at(free_slots.size() - 1);
+		} else {
+			slot = point_ids.size();
+			point_ids.push_back(0);
+			point_positions.push_back(Vector3());
+			point_weight_scales.push_back(0);
+			point_enabled.push_back(false);
+			point_neighbors.push_back(LocalVector<uint32_t>());
+			point_incoming.push_back(LocalVector<uint32_t>());
+		}
+		point_ids[slot] = p_id;
+		point_enabled[slot] = true;
+		points.set(p_id, slot);
 	}
+
+	point_positions[slot] = p_pos;
+	point_weight_scales[slot] = p_weight_scale;
 }
 
 Vector3 AStar3D::get_point_position(int64_t p_id) const {
-	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t slot = 0;
+	bool p_exists = points.lookup(p_id, slot);
 	ERR_FAIL_COND_V_MSG(!p_exists, Vector3(), vformat("Can't get point's position. Point with id: %d doesn't exist.", p_id));
 
-	return p->pos;
+	return point_positions[slot];
 }
 
 void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
-	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t slot = 0;
+	bool p_exists = points.lookup(p_id, slot);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
 
-	p->pos = p_pos;
+	point_positions[slot] = p_pos;
 }
 
 real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
-	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t slot = 0;
+	bool p_exists = points.lookup(p_id, slot);
 	ERR_FAIL_COND_V_MSG(!p_exists, 0, vformat("Can't get point's weight scale. Point with id: %d doesn't exist.", p_id));
 
-	return p->weight_scale;
+	return point_weight_scales[slot];
 }
 
 void AStar3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
-	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t slot = 0;
+	bool p_exists = points.lookup(p_id, slot);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's weight scale. Point with id: %d doesn't exist.", p_id));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
 
-	p->weight_scale = p_weight_scale;
+	point_weight_scales[slot] = p_weight_scale;
 }
 
 void AStar3D::remove_point(int64_t p_id) {
-	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t slot = 0;
+	bool p_exists = points.lookup(p_id, slot);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't remove point. Point with id: %d doesn't exist.", p_id));
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-		Segment s(p_id, (*it.key));
+	for (uint32_t neighbor : point_neighbors[slot]) {
+		Segment s(p_id, point_ids[neighbor]);
 		segments.erase(s);
 
-		(*it.value)->neighbors.remove(p->id);
-		(*it.value)->unlinked_neighbours.remove(p->id);
+		point_incoming[neighbor].erase(slot);
 	}
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = p->unlinked_neighbours.iter(); it.valid; it = p->unlinked_neighbours.next_iter(it)) {
-		Segment s(p_id, (*it.key));
+	for (uint32_t neighbor : point_incoming[slot]) {
+		Segment s(p_id, point_ids[neighbor]);
 		segments.erase(s);
 
-		(*it.value)->neighbors.remove(p->id);
-		(*it.value)->unlinked_neighbours.remove(p->id);
+		point_neighbors[neighbor].erase(slot);
 	}
 
-	memdelete(p);
+	// Keep the capacity of the lists, the slot is reused by the next added point.
+	point_neighbors[slot].clear();
+	point_incoming[slot].clear();
+	free_slots.push_back(slot);
+
 	points.remove(p_id);
 	last_free_id = p_id;
 }
 
+void AStar3D::_add_link(uint32_t p_from_slot, uint32_t p_to_slot) {
+	if (!point_neighbors[p_from_slot].has(p_to_slot)) {
+		point_neighbors[p_from_slot].push_back(p_to_slot);
+		point_incoming[p_to_slot].push_back(p_from_slot);
+	}
+}
+
+void AStar3D::_remove_link(uint32_t p_from_slot, uint32_t p_to_slot) {
+	if (point_neighbors[p_from_slot].erase(p_to_slot)) {
+		point_incoming[p_to_slot].erase(p_from_slot);
+	}
+}
+
 void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
 	ERR_FAIL_COND_MSG(p_id == p_with_id, vformat("Can't connect point with id: %d to itself.", p_id));
 
-	Point *a = nullptr;
+	uint32_t a = 0;
 	bool from_exists = points.lookup(p_id, a);
 	ERR_FAIL_COND_MSG(!from_exists, vformat("Can't connect points. Point with id: %d doesn't exist.", p_id));
 
-	Point *b = nullptr;
+	uint32_t b = 0;
 	bool to_exists = points.lookup(p_with_id, b);
 	ERR_FAIL_COND_MSG(!to_exists, vformat("Can't connect points. Point with id: %d doesn't exist.", p_with_id));
 
-	a->neighbors.set(b->id, b);
-
+	_add_link(a, b);
 	if (bidirectional) {
-		b->neighbors.set(a->id, a);
-	} else {
-		b->unlinked_neighbours.set(a->id, a);
+		_add_link(b, a);
 	}
 
 	Segment s(p_id, p_with_id);
@@ -155,11 +173,6 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 	HashSet<Segment, Segment>::Iterator element = segments.find(s);
 	if (element) {
 		s.direction |= element->direction;
-		if (s.direction == Segment::BIDIRECTIONAL) {
-			// Both are neighbors of each other now
-			a->unlinked_neighbours.remove(b->id);
-			b->unlinked_neighbours.remove(a->id);
-		}
 		segments.remove(element);
 	}
 
@@ -167,11 +180,11 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 }
 
 void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
-	Point *a = nullptr;
+	uint32_t a = 0;
 	bool a_exists = points.lookup(p_id, a);
 	ERR_FAIL_COND_MSG(!a_exists, vformat("Can't disconnect points. Point with id: %d doesn't exist.", p_id));
 
-	Point *b = nullptr;
+	uint32_t b = 0;
 	bool b_exists = points.lookup(p_with_id, b);
 	ERR_FAIL_COND_MSG(!b_exists, vformat("Can't disconnect points. Point with id: %d doesn't exist.", p_with_id));
 
@@ -184,19 +197,9 @@ void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectio
 		// Erase the directions to be removed
 		s.direction = (element->direction & ~remove_direction);
 
-		a->neighbors.remove(b->id);
+		_remove_link(a, b);
 		if (bidirectional) {
-			b->neighbors.remove(a->id);
-			if (element->direction != Segment::BIDIRECTIONAL) {
-				a->unlinked_neighbours.remove(b->id);
-				b->unlinked_neighbours.remove(a->id);
-			}
-		} else {
-			if (s.direction == Segment::NONE) {
-				b->unlinked_neighbours.remove(a->id);
-			} else {
-				a->unlinked_neighbours.set(b->id, b);
-			}
+			_remove_link(b, a);
 		}
 
 		segments.remove(element);
@@ -213,7 +216,7 @@ bool AStar3D::has_point(int64_t p_id) const {
 PackedInt64Array AStar3D::get_point_ids() {
 	PackedInt64Array point_list;
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+	for (OAHashMap<int64_t, uint32_t>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
 		point_list.push_back(*(it.key));
 	}
 
@@ -221,14 +224,14 @@ PackedInt64Array AStar3D::get_point_ids() {
 }
 
 Vector<int64_t> AStar3D::get_point_connections(int64_t p_id) {
-	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t slot = 0;
+	bool p_exists = points.lookup(p_id, slot);
 	ERR_FAIL_COND_V_MSG(!p_exists, Vector<int64_t>(), vformat("Can't get point's connections. Point with id: %d doesn't exist.", p_id));
 
 	Vector<int64_t> point_list;
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-		point_list.push_back((*it.key));
+	for (uint32_t neighbor : point_neighbors[slot]) {
+		point_list.push_back(point_ids[neighbor]);
 	}
 
 	return point_list;
@@ -244,9 +247,13 @@ bool AStar3D::are_points_connected(int64_t p_id, int64_t p_with_id, bool bidirec
 
 void AStar3D::clear() {
 	last_free_id = 0;
-	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
-		memdelete(*(it.value));
-	}
+	point_ids.clear();
+	point_positions.clear();
+	point_weight_scales.clear();
+	point_enabled.clear();
+	point_neighbors.clear();
+	point_incoming.clear();
+	free_slots.clear();
 	segments.clear();
 	points.clear();
 }
@@ -263,20 +270,27 @@ void AStar3D::reserve_space(int64_t p_num_nodes) {
 	ERR_FAIL_COND_MSG(p_num_nodes <= 0, vformat("New capacity must be greater than 0, new was: %d.", p_num_nodes));
 	ERR_FAIL_COND_MSG((uint32_t)p_num_nodes < points.get_capacity(), vformat("New capacity must be greater than current capacity: %d, new was: %d.", points.get_capacity(), p_num_nodes));
 	points.reserve(p_num_nodes);
+	point_ids.reserve(p_num_nodes);
+	point_positions.reserve(p_num_nodes);
+	point_weight_scales.reserve(p_num_nodes);
+	point_enabled.reserve(p_num_nodes);
+	point_neighbors.reserve(p_num_nodes);
+	point_incoming.reserve(p_num_nodes);
 }
 
 int64_t AStar3D::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
 	int64_t closest_id = -1;
 	real_t closest_dist = 1e20;
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
-		if (!p_include_disabled && !(*it.value)->enabled) {
+	for (OAHashMap<int64_t, uint32_t>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		const uint32_t slot = *(it.value);
+		if (!p_include_disabled && !point_enabled[slot]) {
 			continue; // Disabled points should not be considered.
 		}
 
 		// Keep the closest point's ID, and in case of multiple closest IDs,
 		// the smallest one (makes it deterministic).
-		real_t d = p_point.distance_squared_to((*it.value)->pos);
+		real_t d = p_point.distance_squared_to(point_positions[slot]);
 		int64_t id = *(it.key);
 		if (d <= closest_dist) {
 			if (d == closest_dist && id > closest_id) { // Keep lowest ID.
@@ -295,17 +309,17 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	Vector3 closest_point;
 
 	for (const Segment &E : segments) {
-		Point *from_point = nullptr, *to_point = nullptr;
-		points.lookup(E.key.first, from_point);
-		points.lookup(E.key.second, to_point);
+		uint32_t from_slot = 0, to_slot = 0;
+		points.lookup(E.key.first, from_slot);
+		points.lookup(E.key.second, to_slot);
 
-		if (!(from_point->enabled && to_point->enabled)) {
+		if (!(point_enabled[from_slot] && point_enabled[to_slot])) {
 			continue;
 		}
 
 		Vector3 segment[2] = {
-			from_point->pos,
-			to_point->pos,
+			point_positions[from_slot],
+			point_positions[to_slot],
 		};
 
 		Vector3 p = Geometry3D::get_closest_point_to_segment(p_point, segment);
@@ -319,66 +333,111 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar3D::_solve(Point *begin_point, Point *end_point) {
-	last_closest_point = nullptr;
-	pass++;
+void AStar3D::set_bidirectional_search_enabled(bool p_enabled) {
+	bidirectional_search_enabled = p_enabled;
+}
+
+bool AStar3D::is_bidirectional_search_enabled() const {
+	return bidirectional_search_enabled;
+}
+
+AStar3D::SolveContext *AStar3D::_acquire_context() {
+	SolveContext *context = nullptr;
+	{
+		MutexLock lock(contexts_mutex);
+		if (!free_contexts.is_empty()) {
+			context = free_contexts[free_contexts.size() - 1];
+			free_contexts.remove_at(free_contexts.size() - 1);
+		}
+	}
+	if (!context) {
+		context = memnew(SolveContext);
+	}
+	// States of reused slots are harmless, their passes are always behind the context's.
+	if (context->states.size() < point_ids.size()) {
+		context->states.resize(point_ids.size());
+		context->backward_states.resize(point_ids.size());
+	}
+	return context;
+}
 
-	if (!end_point->enabled) {
+void AStar3D::_release_context(SolveContext *p_context) {
+	MutexLock lock(contexts_mutex);
+	free_contexts.push_back(p_context);
+}
+
+template <typename T>
+bool AStar3D::_solve(T *p_costs, SolveContext &r_context, uint32_t p_begin_slot, uint32_t p_end_slot) {
+	r_context.last_closest_point = UINT32_MAX;
+	r_context.pass++;
+
+	if (!point_enabled[p_end_slot]) {
 		return false;
 	}
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	const uint64_t pass = r_context.pass;
+	PointState *states = r_context.states.ptr();
+	LocalVector<uint32_t> &open_list = r_context.open_list;
+	SortArray<uint32_t, SortPoints> sorter;
+	sorter.compare.states = states;
+
+	const int64_t end_id = point_ids[p_end_slot];
 
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	begin_point->abs_g_score = 0;
-	begin_point->abs_f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	open_list.clear();
+
+	states[p_begin_slot].g_score = 0;
+	states[p_begin_slot].f_score = p_costs->_estimate_cost(point_ids[p_begin_slot], end_id);
+	states[p_begin_slot].abs_g_score = 0;
+	states[p_begin_slot].abs_f_score = p_costs->_estimate_cost(point_ids[p_begin_slot], end_id);
+	open_list.push_back(p_begin_slot);
+
+	PointState *last_closest_state = nullptr;
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		const uint32_t p = open_list[0]; // The currently processed point.
+		PointState &p_state = states[p];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		if (last_closest_state == nullptr || last_closest_state->abs_f_score > p_state.abs_f_score || (last_closest_state->abs_f_score >= p_state.abs_f_score && last_closest_state->abs_g_score > p_state.abs_g_score)) {
+			r_context.last_closest_point = p;
+			last_closest_state = &p_state;
 		}
 
-		if (p == end_point) {
+		if (p == p_end_slot) {
 			found_route = true;
 			break;
 		}
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		p_state.closed_pass = pass; // Mark the point as closed.
 
-		for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-			Point *e = *(it.value); // The neighbor point.
+		for (uint32_t e : point_neighbors[p]) { // The neighbor point.
+			PointState &e_state = states[e];
 
-			if (!e->enabled || e->closed_pass == pass) {
+			if (!point_enabled[e] || e_state.closed_pass == pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = p_state.g_score + p_costs->_compute_cost(point_ids[p], point_ids[e]) * point_weight_scales[e];
 
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
+			if (e_state.open_pass != pass) { // The point wasn't inside the open list.
+				e_state.open_pass = pass;
 				open_list.push_back(e);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			e_state.prev_point = p;
+			e_state.g_score = tentative_g_score;
+			e_state.f_score = e_state.g_score + p_costs->_estimate_cost(point_ids[e], end_id);
+			e_state.abs_g_score = tentative_g_score;
+			e_state.abs_f_score = e_state.f_score - e_state.g_score;
 
 			if (new_point) { // The position of the new points is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
@@ -391,21 +450,177 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point) {
 	return found_route;
 }
 
+template <typename T>
+bool AStar3D::_solve_bidirectional(T *p_costs, SolveContext &r_context, uint32_t p_begin_slot, uint32_t p_end_slot) {
+	r_context.pass++;
+
+	if (!point_enabled[p_end_slot]) {
+		return false;
+	}
+
+	// Index 0 searches forward from the begin point over the outgoing connections,
+	// index 1 searches backward from the end point over the incoming ones.
+	const uint64_t pass = r_context.pass;
+	PointState *states[2] = { r_context.states.ptr(), r_context.backward_states.ptr() };
+	LocalVector<uint32_t> *open_lists[2] = { &r_context.open_list, &r_context.backward_open_list };
+	const LocalVector<LocalVector<uint32_t>> *links[2] = { &point_neighbors, &point_incoming };
+	SortArray<uint32_t, SortPoints> sorters[2];
+	sorters[0].compare.states = states[0];
+	sorters[1].compare.states = states[1];
+
+	const int64_t begin_id = point_ids[p_begin_slot];
+	const int64_t end_id = point_ids[p_end_slot];
+	const uint32_t start_slots[2] = { p_begin_slot, p_end_slot };
+
+	for (int side = 0; side < 2; side++) {
+		PointState &start_state = states[side][start_slots[side]];
+		start_state.g_score = 0;
+		start_state.f_score = p_costs->_estimate_cost(begin_id, end_id);
+		start_state.open_pass = pass;
+		open_lists[side]->clear();
+		open_lists[side]->push_back(start_slots[side]);
+	}
+
+	real_t best_cost = FLT_MAX;
+	uint32_t meeting_point = UINT32_MAX;
+
+	while (!open_lists[0]->is_empty() && !open_lists[1]->is_empty()) {
+		// No point left on either side can lead to a cheaper path than the best one found.
+		if (states[0][(*open_lists[0])[0]].f_score >= best_cost || states[1][(*open_lists[1])[0]].f_score >= best_cost) {
+			break;
+		}
+
+		// Grow the smaller frontier.
+		const int side = open_lists[0]->size() <= open_lists[1]->size() ? 0 : 1;
+		LocalVector<uint32_t> &open_list = *open_lists[side];
+		PointState *side_states = states[side];
+		const PointState *other_states = states[1 - side];
+
+		const uint32_t p = open_list[0]; // The currently processed point.
+		sorters[side].pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
+		open_list.remove_at(open_list.size() - 1);
+		side_states[p].closed_pass = pass; // Mark the point as closed.
+
+		for (uint32_t e : (*links[side])[p]) {
+			PointState &e_state = side_states[e];
+
+			// The begin point may be disabled, the backward search still has to reach it.
+			if ((!point_enabled[e] && e != p_begin_slot) || e_state.closed_pass == pass) {
+				continue;
+			}
+
+			real_t tentative_g_score = side_states[p].g_score;
+			if (side == 0) {
+				tentative_g_score += p_costs->_compute_cost(point_ids[p], point_ids[e]) * point_weight_scales[e];
+			} else {
+				tentative_g_score += p_costs->_compute_cost(point_ids[e], point_ids[p]) * point_weight_scales[p];
+			}
+
+			bool new_point = false;
+
+			if (e_state.open_pass != pass) { // The point wasn't inside the open list.
+				e_state.open_pass = pass;
+				open_list.push_back(e);
+				new_point = true;
+			} else if (tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
+				continue;
+			}
+
+			e_state.prev_point = p;
+			e_state.g_score = tentative_g_score;
+			e_state.f_score = e_state.g_score + (side == 0 ? p_costs->_estimate_cost(point_ids[e], end_id) : p_costs->_estimate_cost(begin_id, point_ids[e]));
+
+			if (new_point) { // The position of the new points is already known.
+				sorters[side].push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
+			} else {
+				sorters[side].push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+			}
+
+			// A point reached from both sides joins the two halves into a path.
+			if (other_states[e].open_pass == pass && e_state.g_score + other_states[e].g_score < best_cost) {
+				best_cost = e_state.g_score + other_states[e].g_score;
+				meeting_point = e;
+			}
+		}
+	}
+
+	if (meeting_point == UINT32_MAX) {
+		return false;
+	}
+
+	LocalVector<uint32_t> &path = r_context.path;
+	path.clear();
+	for (uint32_t p = meeting_point;; p = states[0][p].prev_point) {
+		path.push_back(p);
+		if (p == p_begin_slot) {
+			break;
+		}
+	}
+	path.invert();
+	for (uint32_t p = meeting_point; p != p_end_slot;) {
+		p = states[1][p].prev_point;
+		path.push_back(p);
+	}
+
+	return true;
+}
+
+template <typename T>
+bool AStar3D::_find_path(T *p_costs, SolveContext &r_context, uint32_t p_begin_slot, uint32_t p_end_slot, bool p_allow_partial_path) {
+	LocalVector<uint32_t> &path = r_context.path;
+	path.clear();
+
+	if (p_begin_slot == p_end_slot) {
+		path.push_back(p_begin_slot);
+		return true;
+	}
+
+	if (bidirectional_search_enabled) {
+		// The closest point for partial paths needs the full forward search, run it when there is no route.
+		if (_solve_bidirectional(p_costs, r_context, p_begin_slot, p_end_slot) || !p_allow_partial_path) {
+			return !path.is_empty();
+		}
+	}
+
+	uint32_t end_slot = p_end_slot;
+
+	bool found_route = _solve(p_costs, r_context, p_begin_slot, end_slot);
+	if (!found_route) {
+		if (!p_allow_partial_path || r_context.last_closest_point == UINT32_MAX) {
+			return false;
+		}
+
+		// Use closest point instead.
+		end_slot = r_context.last_closest_point;
+	}
+
+	const PointState *states = r_context.states.ptr();
+	for (uint32_t p = end_slot;; p = states[p].prev_point) {
+		path.push_back(p);
+		if (p == p_begin_slot) {
+			break;
+		}
+	}
+	path.invert();
+
+	return true;
+}
+
 real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_to_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_to_id, scost)) {
 		return scost;
 	}
 
-	Point *from_point = nullptr;
-	bool from_exists = points.lookup(p_from_id, from_point);
+	uint32_t from_slot = 0;
+	bool from_exists = points.lookup(p_from_id, from_slot);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
 
-	Point *to_point = nullptr;
-	bool to_exists = points.lookup(p_to_id, to_point);
+	uint32_t to_slot = 0;
+	bool to_exists = points.lookup(p_to_id, to_slot);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_to_id));
 
-	return from_point->pos.distance_to(to_point->pos);
+	return point_positions[from_slot].distance_to(point_positions[to_slot]);
 }
 
 real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
@@ -414,139 +629,79 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
-	Point *from_point = nullptr;
-	bool from_exists = points.lookup(p_from_id, from_point);
+	uint32_t from_slot = 0;
+	bool from_exists = points.lookup(p_from_id, from_slot);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
 
-	Point *to_point = nullptr;
-	bool to_exists = points.lookup(p_to_id, to_point);
+	uint32_t to_slot = 0;
+	bool to_exists = points.lookup(p_to_id, to_slot);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_to_id));
 
-	return from_point->pos.distance_to(to_point->pos);
+	return point_positions[from_slot].distance_to(point_positions[to_slot]);
 }
 
 Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
-	Point *a = nullptr;
+	uint32_t a = 0;
 	bool from_exists = points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
 
-	Point *b = nullptr;
+	uint32_t b = 0;
 	bool to_exists = points.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<Vector3> ret;
-		ret.push_back(a->pos);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return Vector<Vector3>();
-		}
-
-		// Use closest point instead.
-		end_point = last_closest_point;
-	}
-
-	Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<Vector3> path;
-	path.resize(pc);
 
-	{
+	SolveContext *context = _acquire_context();
+	if (_find_path(this, *context, a, b, p_allow_partial_path)) {
+		path.resize(context->path.size());
 		Vector3 *w = path.ptrw();
-
-		Point *p2 = end_point;
-		int64_t idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
+		for (uint32_t i = 0; i < context->path.size(); i++) {
+			w[i] = point_positions[context->path[i]];
 		}
-
-		w[0] = p2->pos; // Assign first
 	}
+	_release_context(context);
 
 	return path;
 }
 
 Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
-	Point *a = nullptr;
+	uint32_t a = 0;
 	bool from_exists = points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 
-	Point *b = nullptr;
+	uint32_t b = 0;
 	bool to_exists = points.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<int64_t> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return Vector<int64_t>();
-		}
-
-		// Use closest point instead.
-		end_point = last_closest_point;
-	}
-
-	Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<int64_t> path;
-	path.resize(pc);
 
-	{
+	SolveContext *context = _acquire_context();
+	if (_find_path(this, *context, a, b, p_allow_partial_path)) {
+		path.resize(context->path.size());
 		int64_t *w = path.ptrw();
-
-		p = end_point;
-		int64_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
+		for (uint32_t i = 0; i < context->path.size(); i++) {
+			w[i] = point_ids[context->path[i]];
 		}
-
-		w[0] = p->id; // Assign first
 	}
+	_release_context(context);
 
 	return path;
 }
 
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
-	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t slot = 0;
+	bool p_exists = points.lookup(p_id, slot);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
 
-	p->enabled = !p_disabled;
+	point_enabled[slot] = !p_disabled;
 }
 
 bool AStar3D::is_point_disabled(int64_t p_id) const {
-	Point *p = nullptr;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t slot = 0;
+	bool p_exists = points.lookup(p_id, slot);
 	ERR_FAIL_COND_V_MSG(!p_exists, false, vformat("Can't get if point is disabled. Point with id: %d doesn't exist.", p_id));
 
-	return !p->enabled;
+	return !point_enabled[slot];
 }
 
 void AStar3D::_bind_methods() {
@@ -576,15 +731,23 @@ void AStar3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar3D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar3D::get_closest_position_in_segment);
 
+	ClassDB::bind_method(D_METHOD("set_bidirectional_search_enabled", "enabled"), &AStar3D::set_bidirectional_search_enabled);
+	ClassDB::bind_method(D_METHOD("is_bidirectional_search_enabled"), &AStar3D::is_bidirectional_search_enabled);
+
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_id_path, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "bidirectional_search_enabled"), "set_bidirectional_search_enabled", "is_bidirectional_search_enabled");
 }
 
 AStar3D::~AStar3D() {
 	clear();
+	for (SolveContext *context : free_contexts) {
+		memdelete(context);
+	}
 }
 
 /////////////////////////////////////////////////////////////
@@ -675,21 +838,29 @@ Vector2 AStar2D::get_closest_position_in_segment(const Vector2 &p_point) const {
 	return Vector2(p.x, p.y);
 }
 
+void AStar2D::set_bidirectional_search_enabled(bool p_enabled) {
+	astar.set_bidirectional_search_enabled(p_enabled);
+}
+
+bool AStar2D::is_bidirectional_search_enabled() const {
+	return astar.is_bidirectional_search_enabled();
+}
+
 real_t AStar2D::_estimate_cost(int64_t p_from_id, int64_t p_to_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_to_id, scost)) {
 		return scost;
 	}
 
-	AStar3D::Point *from_point = nullptr;
-	bool from_exists = astar.points.lookup(p_from_id, from_point);
+	uint32_t from_slot = 0;
+	bool from_exists = astar.points.lookup(p_from_id, from_slot);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
 
-	AStar3D::Point *to_point = nullptr;
-	bool to_exists = astar.points.lookup(p_to_id, to_point);
+	uint32_t to_slot = 0;
+	bool to_exists = astar.points.lookup(p_to_id, to_slot);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_to_id));
 
-	return from_point->pos.distance_to(to_point->pos);
+	return astar.point_positions[from_slot].distance_to(astar.point_positions[to_slot]);
 }
 
 real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
@@ -698,196 +869,66 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
-	AStar3D::Point *from_point = nullptr;
-	bool from_exists = astar.points.lookup(p_from_id, from_point);
+	uint32_t from_slot = 0;
+	bool from_exists = astar.points.lookup(p_from_id, from_slot);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
 
-	AStar3D::Point *to_point = nullptr;
-	bool to_exists = astar.points.lookup(p_to_id, to_point);
+	uint32_t to_slot = 0;
+	bool to_exists = astar.points.lookup(p_to_id, to_slot);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_to_id));
 
-	return from_point->pos.distance_to(to_point->pos);
+	return astar.point_positions[from_slot].distance_to(astar.point_positions[to_slot]);
 }
 
 Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
-	AStar3D::Point *a = nullptr;
+	uint32_t a = 0;
 	bool from_exists = astar.points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
 
-	AStar3D::Point *b = nullptr;
+	uint32_t b = 0;
 	bool to_exists = astar.points.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<Vector2> ret = { Vector2(a->pos.x, a->pos.y) };
-		return ret;
-	}
-
-	AStar3D::Point *begin_point = a;
-	AStar3D::Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
-			return Vector<Vector2>();
-		}
-
-		// Use closest point instead.
-		end_point = astar.last_closest_point;
-	}
-
-	AStar3D::Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<Vector2> path;
-	path.resize(pc);
 
-	{
+	AStar3D::SolveContext *context = astar._acquire_context();
+	if (astar._find_path(this, *context, a, b, p_allow_partial_path)) {
+		path.resize(context->path.size());
 		Vector2 *w = path.ptrw();
-
-		AStar3D::Point *p2 = end_point;
-		int64_t idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
+		for (uint32_t i = 0; i < context->path.size(); i++) {
+			const Vector3 &pos = astar.point_positions[context->path[i]];
+			w[i] = Vector2(pos.x, pos.y);
 		}
-
-		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
 	}
+	astar._release_context(context);
 
 	return path;
 }
 
 Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
-	AStar3D::Point *a = nullptr;
+	uint32_t a = 0;
 	bool from_exists = astar.points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 
-	AStar3D::Point *b = nullptr;
+	uint32_t b = 0;
 	bool to_exists = astar.points.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<int64_t> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
-
-	AStar3D::Point *begin_point = a;
-	AStar3D::Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
-			return Vector<int64_t>();
-		}
-
-		// Use closest point instead.
-		end_point = astar.last_closest_point;
-	}
-
-	AStar3D::Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<int64_t> path;
-	path.resize(pc);
 
-	{
+	AStar3D::SolveContext *context = astar._acquire_context();
+	if (astar._find_path(this, *context, a, b, p_allow_partial_path)) {
+		path.resize(context->path.size());
 		int64_t *w = path.ptrw();
-
-		p = end_point;
-		int64_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
+		for (uint32_t i = 0; i < context->path.size(); i++) {
+			w[i] = astar.point_ids[context->path[i]];
 		}
-
-		w[0] = p->id; // Assign first
 	}
+	astar._release_context(context);
 
 	return path;
 }
 
-bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point) {
-	astar.last_closest_point = nullptr;
-	astar.pass++;
-
-	if (!end_point->enabled) {
-		return false;
-	}
-
-	bool found_route = false;
-
-	LocalVector<AStar3D::Point *> open_list;
-	SortArray<AStar3D::Point *, AStar3D::SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	begin_point->abs_g_score = 0;
-	begin_point->abs_f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
-
-	while (!open_list.is_empty()) {
-		AStar3D::Point *p = open_list[0]; // The currently processed point.
-
-		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (astar.last_closest_point == nullptr || astar.last_closest_point->abs_f_score > p->abs_f_score || (astar.last_closest_point->abs_f_score >= p->abs_f_score && astar.last_closest_point->abs_g_score > p->abs_g_score)) {
-			astar.last_closest_point = p;
-		}
-
-		if (p == end_point) {
-			found_route = true;
-			break;
-		}
-
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed.
-
-		for (OAHashMap<int64_t, AStar3D::Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-			AStar3D::Point *e = *(it.value); // The neighbor point.
-
-			if (!e->enabled || e->closed_pass == astar.pass) {
-				continue;
-			}
-
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
-
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
-				continue;
-			}
-
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
-
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
-			}
-		}
-	}
-
-	return found_route;
-}
-
 void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_available_point_id"), &AStar2D::get_available_point_id);
 	ClassDB::bind_method(D_METHOD("add_point", "id", "position", "weight_scale"), &AStar2D::add_point, DEFVAL(1.0));
@@ -915,9 +956,14 @@ void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar2D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar2D::get_closest_position_in_segment);
 
+	ClassDB::bind_method(D_METHOD("set_bidirectional_search_enabled", "enabled"), &AStar2D::set_bidirectional_search_enabled);
+	ClassDB::bind_method(D_METHOD("is_bidirectional_search_enabled"), &AStar2D::is_bidirectional_search_enabled);
+
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_id_path, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "bidirectional_search_enabled"), "set_bidirectional_search_enabled", "is_bidirectional_search_enabled");
 }
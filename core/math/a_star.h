@@ -33,6 +33,8 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 
 /**
@@ -43,19 +45,9 @@ class AStar3D : public RefCounted {
 	GDCLASS(AStar3D, RefCounted);
 	friend class AStar2D;
 
-	struct Point {
-		Point() {}
-
-		int64_t id = 0;
-		Vector3 pos;
-		real_t weight_scale = 0;
-		bool enabled = false;
-
-		OAHashMap<int64_t, Point *> neighbors = 4u;
-		OAHashMap<int64_t, Point *> unlinked_neighbours = 4u;
-
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
+	// Search state of a point. Kept out of the point storage so that several queries can run at once.
+	struct PointState {
+		uint32_t prev_point = 0;
 		real_t g_score = 0;
 		real_t f_score = 0;
 		uint64_t open_pass = 0;
@@ -67,17 +59,31 @@ class AStar3D : public RefCounted {
 	};
 
 	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+		const PointState *states = nullptr;
+
+		_FORCE_INLINE_ bool operator()(uint32_t A, uint32_t B) const { // Returns true when the Point A is worse than Point B.
+			if (states[A].f_score > states[B].f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (states[A].f_score < states[B].f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return states[A].g_score < states[B].g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
+	// Everything a single query writes to. Contexts are pooled and reused between queries.
+	struct SolveContext {
+		LocalVector<PointState> states;
+		LocalVector<PointState> backward_states;
+		LocalVector<uint32_t> open_list;
+		LocalVector<uint32_t> backward_open_list;
+		LocalVector<uint32_t> path;
+		uint32_t last_closest_point = UINT32_MAX;
+
+		uint64_t pass = 1;
+	};
+
 	struct Segment {
 		Pair<int64_t, int64_t> key;
 
@@ -109,13 +115,35 @@ class AStar3D : public RefCounted {
 	};
 
 	int64_t last_free_id = 0;
-	uint64_t pass = 1;
+	bool bidirectional_search_enabled = false;
+
+	// Points are stored as parallel arrays indexed by slot. Slots of removed points are reused.
+	OAHashMap<int64_t, uint32_t> points; // Point ID to slot.
+	LocalVector<int64_t> point_ids;
+	LocalVector<Vector3> point_positions;
+	LocalVector<real_t> point_weight_scales;
+	LocalVector<bool> point_enabled;
+	LocalVector<LocalVector<uint32_t>> point_neighbors; // Slots the point connects to.
+	LocalVector<LocalVector<uint32_t>> point_incoming; // Slots connecting to the point.
+	LocalVector<uint32_t> free_slots;
 
-	OAHashMap<int64_t, Point *> points;
 	HashSet<Segment, Segment> segments;
-	Point *last_closest_point = nullptr;
 
-	bool _solve(Point *begin_point, Point *end_point);
+	LocalVector<SolveContext *> free_contexts;
+	BinaryMutex contexts_mutex;
+
+	void _add_link(uint32_t p_from_slot, uint32_t p_to_slot);
+	void _remove_link(uint32_t p_from_slot, uint32_t p_to_slot);
+
+	SolveContext *_acquire_context();
+	void _release_context(SolveContext *p_context);
+
+	template <typename T>
+	bool _solve(T *p_costs, SolveContext &r_context, uint32_t p_begin_slot, uint32_t p_end_slot);
+	template <typename T>
+	bool _solve_bidirectional(T *p_costs, SolveContext &r_context, uint32_t p_begin_slot, uint32_t p_end_slot);
+	template <typename T>
+	bool _find_path(T *p_costs, SolveContext &r_context, uint32_t p_begin_slot, uint32_t p_end_slot, bool p_allow_partial_path);
 
 protected:
 	static void _bind_methods();
@@ -160,6 +188,9 @@ public:
 	int64_t get_closest_point(const Vector3 &p_point, bool p_include_disabled = false) const;
 	Vector3 get_closest_position_in_segment(const Vector3 &p_point) const;
 
+	void set_bidirectional_search_enabled(bool p_enabled);
+	bool is_bidirectional_search_enabled() const;
+
 	Vector<Vector3> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 
@@ -169,10 +200,9 @@ public:
 
 class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
+	friend class AStar3D;
 	AStar3D astar;
 
-	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point);
-
 protected:
 	static void _bind_methods();
 
@@ -216,6 +246,9 @@ public:
 	int64_t get_closest_point(const Vector2 &p_point, bool p_include_disabled = false) const;
 	Vector2 get_closest_position_in_segment(const Vector2 &p_point) const;
 
+	void set_bidirectional_search_enabled(bool p_enabled);
+	bool is_bidirectional_search_enabled() const;
+
 	Vector<Vector2> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 
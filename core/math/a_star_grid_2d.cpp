@@ -31,6 +31,7 @@
 #include "a_star_grid_2d.h"
 #include "a_star_grid_2d.compat.inc"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/typed_array.h"
 
 static real_t heuristic_euclidean(const Vector2i &p_from, const Vector2i &p_to) {
@@ -127,13 +128,13 @@ void AStarGrid2D::update() {
 	}
 
 	points.clear();
+	points.reserve(region.size.x * region.size.y);
 
 	const int32_t end_x = region.get_end().x;
 	const int32_t end_y = region.get_end().y;
 	const Vector2 half_cell_size = cell_size / 2;
 
 	for (int32_t y = region.position.y; y < end_y; y++) {
-		LocalVector<Point> line;
 		for (int32_t x = region.position.x; x < end_x; x++) {
 			Vector2 v = offset;
 			switch (cell_shape) {
@@ -149,11 +150,11 @@ void AStarGrid2D::update() {
 				default:
 					break;
 			}
-			line.push_back(Point(Vector2i(x, y), v));
+			points.push_back(Point(Vector2i(x, y), v));
 		}
-		points.push_back(line);
 	}
 
+	jump_distances_dirty.set();
 	dirty = false;
 }
 
@@ -179,7 +180,10 @@ bool AStarGrid2D::is_jumping_enabled() const {
 
 void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
 	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
-	diagonal_mode = p_diagonal_mode;
+	if (diagonal_mode != p_diagonal_mode) {
+		diagonal_mode = p_diagonal_mode;
+		jump_distances_dirty.set();
+	}
 }
 
 AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
@@ -208,6 +212,7 @@ void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is disabled. Point %s out of bounds %s.", p_id, region));
 	_get_point_unchecked(p_id)->solid = p_solid;
+	jump_distances_dirty.set();
 }
 
 bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
@@ -241,6 +246,7 @@ void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
 			_get_point_unchecked(x, y)->solid = p_solid;
 		}
 	}
+	jump_distances_dirty.set();
 }
 
 void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weight_scale) {
@@ -258,11 +264,97 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
+AStarGrid2D::SolveContext *AStarGrid2D::_acquire_context() {
+	SolveContext *context = nullptr;
+	{
+		MutexLock lock(contexts_mutex);
+		if (!free_contexts.is_empty()) {
+			context = free_contexts[free_contexts.size() - 1];
+			free_contexts.remove_at(free_contexts.size() - 1);
+		}
+	}
+	if (!context) {
+		context = memnew(SolveContext);
+	}
+	// Stale states left over from a previous grid layout are harmless, their passes are always behind.
+	context->states.resize(points.size());
+	return context;
+}
+
+void AStarGrid2D::_release_context(SolveContext *p_context) {
+	MutexLock lock(contexts_mutex);
+	free_contexts.push_back(p_context);
+}
+
+bool AStarGrid2D::_is_jump_forced(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const {
+	// Mirrors the straight move checks in _jump().
+	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
+		if (p_dx != 0) {
+			return (_is_walkable(p_x + p_dx, p_y + 1) && !_is_walkable(p_x, p_y + 1)) || (_is_walkable(p_x + p_dx, p_y - 1) && !_is_walkable(p_x, p_y - 1));
+		}
+		return (_is_walkable(p_x + 1, p_y + p_dy) && !_is_walkable(p_x + 1, p_y)) || (_is_walkable(p_x - 1, p_y + p_dy) && !_is_walkable(p_x - 1, p_y));
+	}
+	if (p_dx != 0) {
+		return (_is_walkable(p_x, p_y + 1) && !_is_walkable(p_x - p_dx, p_y + 1)) || (_is_walkable(p_x, p_y - 1) && !_is_walkable(p_x - p_dx, p_y - 1));
+	}
+	return (_is_walkable(p_x + 1, p_y) && !_is_walkable(p_x + 1, p_y - p_dy)) || (_is_walkable(p_x - 1, p_y) && !_is_walkable(p_x - 1, p_y - p_dy));
+}
+
+void AStarGrid2D::_update_jump_distances() {
+	// Checked once without the lock so that jumping queries on an up to date grid don't contend on it.
+	if (!jump_distances_dirty.is_set()) {
+		return;
+	}
+	MutexLock lock(jump_distances_mutex);
+	if (!jump_distances_dirty.is_set()) {
+		return;
+	}
+
+	static const Vector2i directions[4] = { Vector2i(0, -1), Vector2i(1, 0), Vector2i(0, 1), Vector2i(-1, 0) };
+
+	jump_distances.resize(points.size() * 4);
+
+	const int32_t end_x = region.get_end().x;
+	const int32_t end_y = region.get_end().y;
+
+	for (uint32_t direction = 0; direction < 4; direction++) {
+		const Vector2i step = directions[direction];
+
+		// Sweep against the direction, so the distance of the next point is known when it's needed.
+		const int32_t begin_x = step.x > 0 ? end_x - 1 : region.position.x;
+		const int32_t stop_x = step.x > 0 ? region.position.x - 1 : end_x;
+		const int32_t increment_x = step.x > 0 ? -1 : 1;
+		const int32_t begin_y = step.y > 0 ? end_y - 1 : region.position.y;
+		const int32_t stop_y = step.y > 0 ? region.position.y - 1 : end_y;
+		const int32_t increment_y = step.y > 0 ? -1 : 1;
+
+		for (int32_t y = begin_y; y != stop_y; y += increment_y) {
+			for (int32_t x = begin_x; x != stop_x; x += increment_x) {
+				const int32_t next_x = x + step.x;
+				const int32_t next_y = y + step.y;
+
+				int32_t distance = 0;
+				if (!_is_walkable(next_x, next_y)) {
+					distance = 0;
+				} else if (_is_jump_forced(next_x, next_y, step.x, step.y)) {
+					distance = 1;
+				} else {
+					const int32_t next_distance = jump_distances[_get_point_index(_get_point_unchecked(next_x, next_y)) * 4 + direction];
+					distance = next_distance > 0 ? next_distance + 1 : next_distance - 1;
+				}
+				jump_distances[_get_point_index(_get_point_unchecked(x, y)) * 4 + direction] = distance;
+			}
+		}
+	}
+
+	jump_distances_dirty.clear();
+}
+
+AStarGrid2D::Point *AStarGrid2D::_jump(SolveContext &r_context, Point *p_from, Point *p_to) {
 	if (!p_to || p_to->solid) {
 		return nullptr;
 	}
-	if (p_to == end) {
+	if (p_to == r_context.end) {
 		return p_to;
 	}
 
@@ -275,15 +367,31 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 	int32_t dx = to_x - from_x;
 	int32_t dy = to_y - from_y;
 
+	// Straight runs are looked up in the precomputed jump distances instead of being walked point by point.
+	// Vertical runs without diagonals also look for horizontal jump points on every step, so they still recurse.
+	if ((dx == 0 || dy == 0) && (dy == 0 || diagonal_mode != DIAGONAL_MODE_NEVER)) {
+		const uint32_t direction = dy < 0 ? 0 : (dx > 0 ? 1 : (dy > 0 ? 2 : 3));
+		const int32_t distance = jump_distances[_get_point_index(p_from) * 4 + direction];
+		const Vector2i to_end = r_context.end->id - p_from->id;
+		const int32_t end_steps = dx != 0 ? to_end.x * dx : to_end.y * dy;
+		if ((dx != 0 ? to_end.y == 0 : to_end.x == 0) && end_steps > 0 && end_steps <= ABS(distance)) {
+			return r_context.end;
+		}
+		if (distance > 0) {
+			return _get_point_unchecked(from_x + dx * distance, from_y + dy * distance);
+		}
+		return nullptr;
+	}
+
 	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
 		if (dx != 0 && dy != 0) {
 			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
+			if (_jump(r_context, p_to, _get_point(to_x + dx, to_y)) != nullptr) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
+			if (_jump(r_context, p_to, _get_point(to_x, to_y + dy)) != nullptr) {
 				return p_to;
 			}
 		} else {
@@ -298,17 +406,17 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 			}
 		}
 		if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+			return _jump(r_context, p_to, _get_point(to_x + dx, to_y + dy));
 		}
 	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
 		if (dx != 0 && dy != 0) {
 			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
+			if (_jump(r_context, p_to, _get_point(to_x + dx, to_y)) != nullptr) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
+			if (_jump(r_context, p_to, _get_point(to_x, to_y + dy)) != nullptr) {
 				return p_to;
 			}
 		} else {
@@ -323,7 +431,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 			}
 		}
 		if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+			return _jump(r_context, p_to, _get_point(to_x + dx, to_y + dy));
 		}
 	} else { // DIAGONAL_MODE_NEVER
 		if (dx != 0) {
@@ -334,14 +442,14 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x + 1, to_y)) != nullptr) {
+			if (_jump(r_context, p_to, _get_point(to_x + 1, to_y)) != nullptr) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x - 1, to_y)) != nullptr) {
+			if (_jump(r_context, p_to, _get_point(to_x - 1, to_y)) != nullptr) {
 				return p_to;
 			}
 		}
-		return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+		return _jump(r_context, p_to, _get_point(to_x + dx, to_y + dy));
 	}
 	return nullptr;
 }
@@ -450,9 +558,9 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 	}
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
-	last_closest_point = nullptr;
-	pass++;
+bool AStarGrid2D::_solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point) {
+	r_context.last_closest_point = nullptr;
+	r_context.pass++;
 
 	if (p_end_point->solid) {
 		return false;
@@ -460,22 +568,34 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	const uint64_t pass = r_context.pass;
+	PointState *states = r_context.states.ptr();
+	LocalVector<uint32_t> &open_list = r_context.open_list;
+	LocalVector<Point *> &nbors = r_context.nbors;
+	SortArray<uint32_t, SortPoints> sorter;
+	sorter.compare.states = states;
+
+	open_list.clear();
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	open_list.push_back(p_begin_point);
-	end = p_end_point;
+	const uint32_t begin_index = _get_point_index(p_begin_point);
+	states[begin_index].g_score = 0;
+	states[begin_index].f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	states[begin_index].abs_g_score = 0;
+	states[begin_index].abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	open_list.push_back(begin_index);
+	r_context.end = p_end_point;
+
+	PointState *last_closest_state = nullptr;
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		const uint32_t index = open_list[0];
+		Point *p = &points[index]; // The currently processed point.
+		PointState &state = states[index];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		if (last_closest_state == nullptr || last_closest_state->abs_f_score > state.abs_f_score || (last_closest_state->abs_f_score >= state.abs_f_score && last_closest_state->abs_g_score > state.abs_g_score)) {
+			r_context.last_closest_point = p;
+			last_closest_state = &state;
 		}
 
 		if (p == p_end_point) {
@@ -485,9 +605,9 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		state.closed_pass = pass; // Mark the point as closed.
 
-		LocalVector<Point *> nbors;
+		nbors.clear();
 		_get_nbors(p, nbors);
 
 		for (Point *e : nbors) {
@@ -495,39 +615,42 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				e = _jump(r_context, p, e);
+				if (!e || states[_get_point_index(e)].closed_pass == pass) {
 					continue;
 				}
 			} else {
-				if (e->solid || e->closed_pass == pass) {
+				if (e->solid || states[_get_point_index(e)].closed_pass == pass) {
 					continue;
 				}
 				weight_scale = e->weight_scale;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			const uint32_t e_index = _get_point_index(e);
+			PointState &e_state = states[e_index];
+
+			real_t tentative_g_score = state.g_score + _compute_cost(p->id, e->id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (e_state.open_pass != pass) { // The point wasn't inside the open list.
+				e_state.open_pass = pass;
+				open_list.push_back(e_index);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
+			e_state.prev_point = index;
+			e_state.g_score = tentative_g_score;
+			e_state.f_score = e_state.g_score + _estimate_cost(e->id, p_end_point->id);
 
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			e_state.abs_g_score = tentative_g_score;
+			e_state.abs_f_score = e_state.f_score - e_state.g_score;
 
 			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
+				sorter.push_heap(0, open_list.size() - 1, 0, e_index, open_list.ptr());
 			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+				sorter.push_heap(0, open_list.find(e_index), 0, e_index, open_list.ptr());
 			}
 		}
 	}
@@ -535,6 +658,59 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 	return found_route;
 }
 
+bool AStarGrid2D::_find_path(const Vector2i &p_from_id, const Vector2i &p_to_id, bool p_allow_partial_path, LocalVector<const Point *> &r_path) {
+	Point *begin_point = _get_point_unchecked(p_from_id);
+	Point *end_point = _get_point_unchecked(p_to_id);
+
+	if (begin_point == end_point) {
+		r_path.push_back(begin_point);
+		return true;
+	}
+
+	if (jumping_enabled) {
+		_update_jump_distances();
+	}
+
+	SolveContext *context = _acquire_context();
+
+	bool found_route = _solve(*context, begin_point, end_point);
+	if (!found_route) {
+		if (!p_allow_partial_path || context->last_closest_point == nullptr) {
+			_release_context(context);
+			return false;
+		}
+
+		// Use closest point instead.
+		end_point = context->last_closest_point;
+	}
+
+	const PointState *states = context->states.ptr();
+	const Point *p = end_point;
+	int32_t pc = 1;
+	while (p != begin_point) {
+		pc++;
+		p = &points[states[_get_point_index(p)].prev_point];
+	}
+
+	r_path.resize(pc);
+
+	p = end_point;
+	int32_t idx = pc - 1;
+	while (p != begin_point) {
+		r_path[idx--] = p;
+		p = &points[states[_get_point_index(p)].prev_point];
+	}
+	r_path[0] = p;
+
+	_release_context(context);
+	return true;
+}
+
+void AStarGrid2D::_find_batch_path(void *p_userdata, uint32_t p_index) {
+	PathBatch *batch = static_cast<PathBatch *>(p_userdata);
+	batch->astar->_find_path(batch->from_ids[p_index], batch->to_ids[p_index], batch->allow_partial_path, batch->paths[p_index]);
+}
+
 real_t AStarGrid2D::_estimate_cost(const Vector2i &p_from_id, const Vector2i &p_to_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_to_id, scost)) {
@@ -554,6 +730,7 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 void AStarGrid2D::clear() {
 	points.clear();
 	region = Rect2i();
+	jump_distances_dirty.set();
 }
 
 Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
@@ -567,49 +744,19 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
-
-	if (a == b) {
-		Vector<Vector2> ret;
-		ret.push_back(a->pos);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return Vector<Vector2>();
-		}
-
-		// Use closest point instead.
-		end_point = last_closest_point;
-	}
-
-	Point *p = end_point;
-	int32_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
+	LocalVector<const Point *> points_path;
+	if (!_find_path(p_from_id, p_to_id, p_allow_partial_path, points_path)) {
+		return Vector<Vector2>();
 	}
 
 	Vector<Vector2> path;
-	path.resize(pc);
+	path.resize(points_path.size());
 
 	{
 		Vector2 *w = path.ptrw();
-
-		p = end_point;
-		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->pos;
-			p = p->prev_point;
+		for (uint32_t i = 0; i < points_path.size(); i++) {
+			w[i] = points_path[i]->pos;
 		}
-
-		w[0] = p->pos;
 	}
 
 	return path;
@@ -620,50 +767,65 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
+	LocalVector<const Point *> points_path;
+	if (!_find_path(p_from_id, p_to_id, p_allow_partial_path, points_path)) {
+		return TypedArray<Vector2i>();
+	}
 
-	if (a == b) {
-		TypedArray<Vector2i> ret;
-		ret.push_back(a->id);
-		return ret;
+	TypedArray<Vector2i> path;
+	path.resize(points_path.size());
+	for (uint32_t i = 0; i < points_path.size(); i++) {
+		path[i] = points_path[i]->id;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	return path;
+}
 
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return TypedArray<Vector2i>();
-		}
+Array AStarGrid2D::get_id_paths(const TypedArray<Vector2i> &p_from_ids, const TypedArray<Vector2i> &p_to_ids, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(dirty, Array(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), Array(), vformat("Can't get id paths. The number of start points (%d) doesn't match the number of end points (%d).", p_from_ids.size(), p_to_ids.size()));
 
-		// Use closest point instead.
-		end_point = last_closest_point;
+	PathBatch batch;
+	batch.astar = this;
+	batch.allow_partial_path = p_allow_partial_path;
+	batch.from_ids.resize(p_from_ids.size());
+	batch.to_ids.resize(p_to_ids.size());
+	batch.paths.resize(p_from_ids.size());
+	for (int i = 0; i < p_from_ids.size(); i++) {
+		batch.from_ids[i] = p_from_ids[i];
+		batch.to_ids[i] = p_to_ids[i];
+		ERR_FAIL_COND_V_MSG(!is_in_boundsv(batch.from_ids[i]), Array(), vformat("Can't get id paths. Point %s out of bounds %s.", batch.from_ids[i], region));
+		ERR_FAIL_COND_V_MSG(!is_in_boundsv(batch.to_ids[i]), Array(), vformat("Can't get id paths. Point %s out of bounds %s.", batch.to_ids[i], region));
 	}
 
-	Point *p = end_point;
-	int32_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
+	if (jumping_enabled) {
+		// Built once up front rather than by whichever query gets there first.
+		_update_jump_distances();
 	}
 
-	TypedArray<Vector2i> path;
-	path.resize(pc);
-
-	{
-		p = end_point;
-		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			path[idx--] = p->id;
-			p = p->prev_point;
+	// Script cost overrides can't be called from worker threads, solve those paths one after another.
+	if (batch.paths.size() > 1 && !GDVIRTUAL_IS_OVERRIDDEN(_compute_cost) && !GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost)) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&AStarGrid2D::_find_batch_path, &batch, batch.paths.size(), -1, true, SNAME("AStarGrid2DFindPaths"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < batch.paths.size(); i++) {
+			_find_batch_path(&batch, i);
 		}
+	}
 
-		path[0] = p->id;
+	Array paths;
+	paths.resize(batch.paths.size());
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		const LocalVector<const Point *> &points_path = batch.paths[i];
+		TypedArray<Vector2i> path;
+		path.resize(points_path.size());
+		for (uint32_t j = 0; j < points_path.size(); j++) {
+			path[j] = points_path[j]->id;
+		}
+		paths[i] = path;
 	}
 
-	return path;
+	return paths;
 }
 
 void AStarGrid2D::_bind_methods() {
@@ -700,6 +862,7 @@ void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_point_position", "id"), &AStarGrid2D::get_point_position);
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStarGrid2D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStarGrid2D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStarGrid2D::get_id_paths, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -732,3 +895,9 @@ void AStarGrid2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(CELL_SHAPE_ISOMETRIC_DOWN);
 	BIND_ENUM_CONSTANT(CELL_SHAPE_MAX);
 }
+
+AStarGrid2D::~AStarGrid2D() {
+	for (SolveContext *context : free_contexts) {
+		memdelete(context);
+	}
+}
@@ -33,8 +33,10 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/templates/list.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class AStarGrid2D : public RefCounted {
 	GDCLASS(AStarGrid2D, RefCounted);
@@ -82,8 +84,15 @@ private:
 		Vector2 pos;
 		real_t weight_scale = 1.0;
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
+		Point() {}
+
+		Point(const Vector2i &p_id, const Vector2 &p_pos) :
+				id(p_id), pos(p_pos) {}
+	};
+
+	// Search state of a point. Kept out of Point so that several queries can run on the same grid at once.
+	struct PointState {
+		uint32_t prev_point = 0;
 		real_t g_score = 0;
 		real_t f_score = 0;
 		uint64_t open_pass = 0;
@@ -92,61 +101,95 @@ private:
 		// Used for getting last_closest_point.
 		real_t abs_g_score = 0;
 		real_t abs_f_score = 0;
-
-		Point() {}
-
-		Point(const Vector2i &p_id, const Vector2 &p_pos) :
-				id(p_id), pos(p_pos) {}
 	};
 
 	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+		const PointState *states = nullptr;
+
+		_FORCE_INLINE_ bool operator()(uint32_t A, uint32_t B) const { // Returns true when the Point A is worse than Point B.
+			if (states[A].f_score > states[B].f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (states[A].f_score < states[B].f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return states[A].g_score < states[B].g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
-	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
-	Point *last_closest_point = nullptr;
+	// Everything a single query writes to. Contexts are pooled and reused between queries.
+	struct SolveContext {
+		LocalVector<PointState> states;
+		LocalVector<uint32_t> open_list;
+		LocalVector<Point *> nbors;
+		Point *end = nullptr;
+		Point *last_closest_point = nullptr;
 
-	uint64_t pass = 1;
+		uint64_t pass = 1;
+	};
+
+	struct PathBatch {
+		AStarGrid2D *astar = nullptr;
+		LocalVector<Vector2i> from_ids;
+		LocalVector<Vector2i> to_ids;
+		bool allow_partial_path = false;
+		LocalVector<LocalVector<const Point *>> paths;
+	};
+
+	LocalVector<Point> points; // Row-major, one row per region line.
+
+	LocalVector<SolveContext *> free_contexts;
+	BinaryMutex contexts_mutex;
+
+	// For every point and straight direction (up, right, down, left), the number of steps to the next jump point
+	// when positive, or minus the number of walkable steps before the run hits an obstacle. Used by jump point search.
+	LocalVector<int32_t> jump_distances;
+	SafeFlag jump_distances_dirty = SafeFlag(true);
+	BinaryMutex jump_distances_mutex;
 
 private: // Internal routines.
 	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
 		if (region.has_point(Vector2i(p_x, p_y))) {
-			return !points[p_y - region.position.y][p_x - region.position.x].solid;
+			return !points[(p_y - region.position.y) * region.size.x + p_x - region.position.x].solid;
 		}
 		return false;
 	}
 
 	_FORCE_INLINE_ Point *_get_point(int32_t p_x, int32_t p_y) {
 		if (region.has_point(Vector2i(p_x, p_y))) {
-			return &points[p_y - region.position.y][p_x - region.position.x];
+			return &points[(p_y - region.position.y) * region.size.x + p_x - region.position.x];
 		}
 		return nullptr;
 	}
 
 	_FORCE_INLINE_ Point *_get_point_unchecked(int32_t p_x, int32_t p_y) {
-		return &points[p_y - region.position.y][p_x - region.position.x];
+		return &points[(p_y - region.position.y) * region.size.x + p_x - region.position.x];
 	}
 
 	_FORCE_INLINE_ Point *_get_point_unchecked(const Vector2i &p_id) {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
+		return &points[(p_id.y - region.position.y) * region.size.x + p_id.x - region.position.x];
 	}
 
 	_FORCE_INLINE_ const Point *_get_point_unchecked(const Vector2i &p_id) const {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
+		return &points[(p_id.y - region.position.y) * region.size.x + p_id.x - region.position.x];
 	}
 
+	_FORCE_INLINE_ uint32_t _get_point_index(const Point *p_point) const {
+		return p_point - points.ptr();
+	}
+
+	SolveContext *_acquire_context();
+	void _release_context(SolveContext *p_context);
+
+	bool _is_jump_forced(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const;
+	void _update_jump_distances();
+
 	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point);
+	Point *_jump(SolveContext &r_context, Point *p_from, Point *p_to);
+	bool _solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point);
+	bool _find_path(const Vector2i &p_from_id, const Vector2i &p_to_id, bool p_allow_partial_path, LocalVector<const Point *> &r_path);
+
+	static void _find_batch_path(void *p_userdata, uint32_t p_index);
 
 protected:
 	static void _bind_methods();
@@ -211,6 +254,9 @@ public:
 	Vector2 get_point_position(const Vector2i &p_id) const;
 	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
 	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
+	Array get_id_paths(const TypedArray<Vector2i> &p_from_ids, const TypedArray<Vector2i> &p_to_ids, bool p_allow_partial_path = false);
+
+	~AStarGrid2D();
 };
 
 VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
@@ -189,6 +189,20 @@ private:
 		}
 	};
 
+	template <typename F>
+	struct RangeUserData {
+		const F *func = nullptr;
+		uint32_t count = 0;
+		uint32_t tasks = 0;
+
+		static void process(void *p_userdata, uint32_t p_index) {
+			const RangeUserData *ud = static_cast<const RangeUserData *>(p_userdata);
+			const uint32_t from = uint64_t(ud->count) * p_index / ud->tasks;
+			const uint32_t to = uint64_t(ud->count) * (p_index + 1) / ud->tasks;
+			(*ud->func)(from, to);
+		}
+	};
+
 	void _wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task);
 
 #ifdef THREADS_ENABLED
@@ -235,6 +249,27 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// Calls `p_func(from, to)` over consecutive ranges covering `[0, p_count)`, of at least
+	// `p_min_task_elements` each, and waits for all of them. Runs everything on the calling thread
+	// when that would make a single task, when there is a single worker, or when called from a pool
+	// thread (waiting on a group there could starve the pool).
+	template <typename F>
+	static void process_ranges(uint32_t p_count, uint32_t p_min_task_elements, const F &p_func, const String &p_description = String()) {
+		WorkerThreadPool *pool = get_singleton();
+		const uint32_t tasks = pool ? MIN(p_count / MAX(p_min_task_elements, 1u), uint32_t(pool->get_thread_count()) * 4) : 0;
+		if (tasks < 2 || pool->get_thread_count() < 2 || get_thread_index() != -1) {
+			p_func(0, p_count);
+			return;
+		}
+
+		RangeUserData<F> ud;
+		ud.func = &p_func;
+		ud.count = p_count;
+		ud.tasks = tasks;
+		GroupID group_id = pool->add_native_group_task(&RangeUserData<F>::process, &ud, tasks, -1, true, p_description);
+		pool->wait_for_group_task_completion(group_id);
+	}
+
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
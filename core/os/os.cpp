@@ -71,6 +71,12 @@ void OS::_set_logger(CompositeLogger *p_logger) {
 	_logger = p_logger;
 }
 
+void OS::flush_loggers() {
+	if (_logger) {
+		_logger->flush();
+	}
+}
+
 void OS::add_logger(Logger *p_logger) {
 	if (!_logger) {
 		Vector<Logger *> loggers;
@@ -142,6 +142,8 @@ public:
 	void print(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 	void print_rich(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 	void printerr(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
+	// Writes out anything the loggers still hold in memory. Safe to call from crash handlers.
+	void flush_loggers();
 
 	virtual String get_stdin_string() = 0;
 
@@ -2646,6 +2646,15 @@ void EditorFileSystem::_reimport_thread(uint32_t p_index, ImportThreadData *p_im
 	_reimport_file(p_import_data->reimport_files[current_max].path);
 }
 
+void EditorFileSystem::_add_importer_timing(HashMap<String, ImporterTiming> &r_timings, const String &p_importer, int p_files, uint64_t p_usec) {
+	ImporterTiming &timing = r_timings[p_importer];
+	timing.files += p_files;
+	if (p_files > 1) {
+		timing.threaded_files += p_files;
+	}
+	timing.usec += p_usec;
+}
+
 void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 	ERR_FAIL_COND_MSG(importing, "Attempted to call reimport_files() recursively, this is not allowed.");
 	importing = true;
@@ -2707,65 +2716,114 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 	bool use_multiple_threads = false;
 #endif
 
-	int from = 0;
+	// Time spent and files processed per importer, reported once the batch is done.
+	HashMap<String, ImporterTiming> importer_timings;
+
 	for (int i = 0; i < reimport_files.size(); i++) {
 		if (groups_to_reimport.has(reimport_files[i].path)) {
-			from = i + 1;
 			continue;
 		}
 
+		int batch_end = i + 1;
 		if (use_multiple_threads && reimport_files[i].threaded) {
-			if (i + 1 == reimport_files.size() || reimport_files[i + 1].importer != reimport_files[from].importer || groups_to_reimport.has(reimport_files[i + 1].path)) {
-				if (from - i == 0) {
-					// Single file, do not use threads.
-					pr.step(reimport_files[i].path.get_file(), i);
-					_reimport_file(reimport_files[i].path);
-				} else {
-					Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(reimport_files[from].importer);
-					if (importer.is_null()) {
-						ERR_PRINT(vformat("Invalid importer for \"%s\".", reimport_files[from].importer));
-						from = i + 1;
-						continue;
-					}
+			// Threaded importers with the same import order don't depend on each other, so the files of all of them are imported together.
+			while (batch_end < reimport_files.size() && reimport_files[batch_end].threaded && reimport_files[batch_end].order == reimport_files[i].order && !groups_to_reimport.has(reimport_files[batch_end].path)) {
+				batch_end++;
+			}
+		}
 
-					importer->import_threaded_begin();
+		if (batch_end - i == 1) {
+			// Single file, do not use threads.
+			pr.step(reimport_files[i].path.get_file(), i);
+			uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+			_reimport_file(reimport_files[i].path);
+			_add_importer_timing(importer_timings, reimport_files[i].importer, 1, OS::get_singleton()->get_ticks_usec() - start_usec);
+			continue;
+		}
 
-					ImportThreadData tdata;
-					tdata.max_index.set(from);
-					tdata.reimport_from = from;
-					tdata.reimport_files = reimport_files.ptr();
+		struct ThreadedImportGroup {
+			Ref<ResourceImporter> importer;
+			ImportThreadData data;
+			WorkerThreadPool::GroupID task = 0;
+			int count = 0;
+			int current_index = 0;
+			bool completed = false;
+		};
 
-					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_reimport_thread, &tdata, i - from + 1, -1, false, vformat(TTR("Import resources of type: %s"), reimport_files[from].importer));
-					int current_index = from - 1;
-					do {
-						if (current_index < tdata.max_index.get()) {
-							current_index = tdata.max_index.get();
-							pr.step(reimport_files[current_index].path.get_file(), current_index);
-						}
-						OS::get_singleton()->delay_usec(1);
-					} while (!WorkerThreadPool::get_singleton()->is_group_task_completed(group_task));
+		uint32_t group_count = 1;
+		for (int j = i + 1; j < batch_end; j++) {
+			if (reimport_files[j].importer != reimport_files[j - 1].importer) {
+				group_count++;
+			}
+		}
+
+		LocalVector<ThreadedImportGroup> threaded_groups;
+		threaded_groups.resize(group_count);
 
-					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		// Every importer gets its own group task, and all of them are added before waiting on any.
+		uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		int group_from = i;
+		for (ThreadedImportGroup &group : threaded_groups) {
+			int group_to = group_from + 1;
+			while (group_to < batch_end && reimport_files[group_to].importer == reimport_files[group_from].importer) {
+				group_to++;
+			}
+
+			group.count = group_to - group_from;
+			group.current_index = group_from - 1;
+			group.data.max_index.set(group_from);
+			group.data.reimport_from = group_from;
+			group.data.reimport_files = reimport_files.ptr();
+			group.importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(reimport_files[group_from].importer);
+			if (group.importer.is_null()) {
+				ERR_PRINT(vformat("Invalid importer for \"%s\".", reimport_files[group_from].importer));
+				group.completed = true;
+			} else {
+				group.importer->import_threaded_begin();
+				group.task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_reimport_thread, &group.data, group.count, -1, false, vformat(TTR("Import resources of type: %s"), reimport_files[group_from].importer));
+			}
+			group_from = group_to;
+		}
 
-					importer->import_threaded_end();
+		bool all_completed = true;
+		do {
+			all_completed = true;
+			int started = 0;
+			String started_file;
+			for (ThreadedImportGroup &group : threaded_groups) {
+				if (!group.completed && group.current_index < group.data.max_index.get()) {
+					group.current_index = group.data.max_index.get();
+					started_file = reimport_files[group.current_index].path.get_file();
 				}
+				started += group.current_index - group.data.reimport_from + 1;
 
-				from = i + 1;
+				if (group.completed) {
+					continue;
+				}
+				if (WorkerThreadPool::get_singleton()->is_group_task_completed(group.task)) {
+					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group.task);
+					group.importer->import_threaded_end();
+					group.completed = true;
+					_add_importer_timing(importer_timings, reimport_files[group.data.reimport_from].importer, group.count, OS::get_singleton()->get_ticks_usec() - start_usec);
+				} else {
+					all_completed = false;
+				}
 			}
 
-		} else {
-			pr.step(reimport_files[i].path.get_file(), i);
-			_reimport_file(reimport_files[i].path);
+			if (!started_file.is_empty()) {
+				pr.step(started_file, i + started - 1);
+			}
+			if (!all_completed) {
+				OS::get_singleton()->delay_usec(1);
+			}
+		} while (!all_completed);
 
-			// We need to increment the counter, maybe the next file is multithreaded
-			// and doesn't have the same importer.
-			from = i + 1;
-		}
+		i = batch_end - 1;
 	}
 
 	// Reimport groups.
 
-	from = reimport_files.size();
+	int from = reimport_files.size();
 
 	if (groups_to_reimport.size()) {
 		HashMap<String, Vector<String>> group_files;
@@ -2781,6 +2839,10 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 		}
 	}
 
+	for (const KeyValue<String, ImporterTiming> &E : importer_timings) {
+		print_verbose(vformat("EditorFileSystem: Importer \"%s\" imported %d file(s) in %.3f s%s.", E.key, E.value.files, E.value.usec / 1000000.0, E.value.threaded_files > 0 ? vformat(" (%d threaded)", E.value.threaded_files) : String()));
+	}
+
 	ResourceUID::get_singleton()->update_cache(); // After reimporting, update the cache.
 
 	_save_filesystem_cache();
@@ -314,6 +314,14 @@ class EditorFileSystem : public Node {
 
 	void _reimport_thread(uint32_t p_index, ImportThreadData *p_import_data);
 
+	struct ImporterTiming {
+		int files = 0;
+		int threaded_files = 0;
+		uint64_t usec = 0;
+	};
+
+	static void _add_importer_timing(HashMap<String, ImporterTiming> &r_timings, const String &p_importer, int p_files, uint64_t p_usec);
+
 	static ResourceUID::ID _resource_saver_get_resource_id_for_path(const String &p_path, bool p_generate);
 
 	bool _scan_extensions();
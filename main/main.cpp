@@ -1870,6 +1870,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	GLOBAL_DEF("debug/file_logging/enable_file_logging.pc", true);
 	GLOBAL_DEF("debug/file_logging/log_path", "user://logs/godot.log");
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/file_logging/max_log_files", PROPERTY_HINT_RANGE, "0,20,1,or_greater"), 5);
+	GLOBAL_DEF("debug/file_logging/run_on_separate_thread", false);
 
 	// If `--log-file` is used to override the log path, allow creating logs for the project manager or editor
 	// and even if file logging is disabled in the Project Settings.
@@ -1889,7 +1890,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			base_path = GLOBAL_GET("debug/file_logging/log_path");
 			max_files = GLOBAL_GET("debug/file_logging/max_log_files");
 		}
-		OS::get_singleton()->add_logger(memnew(RotatedFileLogger(base_path, max_files)));
+		OS::get_singleton()->add_logger(memnew(RotatedFileLogger(base_path, max_files, GLOBAL_GET("debug/file_logging/run_on_separate_thread"))));
 	}
 
 	if (main_args.size() == 0 && String(GLOBAL_GET("application/run/main_scene")) == "") {
@@ -30,12 +30,82 @@
 
 #include "image_compress_etcpak.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
 #include <ProcessDxtc.hpp>
 #include <ProcessRGB.hpp>
 
+// A horizontal band of 4x4 blocks from a single mip level, compressed independently of the others.
+struct EtcpakCompressionTask {
+	const uint32_t *src = nullptr;
+	uint64_t *dst = nullptr;
+	uint32_t blocks = 0;
+	uint32_t width = 0;
+};
+
+struct EtcpakCompressionJobQueue {
+	EtcpakType compress_type = EtcpakType::ETCPAK_TYPE_ETC1;
+	const EtcpakCompressionTask *tasks = nullptr;
+};
+
+// Block rows per task. Bands only split the work; every block is encoded the same way, so output is identical to a single pass.
+static const int ETCPAK_BLOCK_ROWS_PER_TASK = 16;
+// Images with fewer blocks than this are compressed on the calling thread.
+static const uint32_t ETCPAK_MIN_BLOCKS_FOR_THREADS = 4096;
+
+static void _compress_etcpak_task(EtcpakType p_compress_type, const EtcpakCompressionTask &p_task) {
+	switch (p_compress_type) {
+		case EtcpakType::ETCPAK_TYPE_ETC1:
+			CompressEtc1RgbDither(p_task.src, p_task.dst, p_task.blocks, p_task.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2:
+			CompressEtc2Rgb(p_task.src, p_task.dst, p_task.blocks, p_task.width, true);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2_ALPHA:
+		case EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG:
+			CompressEtc2Rgba(p_task.src, p_task.dst, p_task.blocks, p_task.width, true);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2_R:
+			CompressEacR(p_task.src, p_task.dst, p_task.blocks, p_task.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2_RG:
+			CompressEacRg(p_task.src, p_task.dst, p_task.blocks, p_task.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_DXT1:
+			CompressDxt1Dither(p_task.src, p_task.dst, p_task.blocks, p_task.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_DXT5:
+		case EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG:
+			CompressDxt5(p_task.src, p_task.dst, p_task.blocks, p_task.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_RGTC_R:
+			CompressBc4(p_task.src, p_task.dst, p_task.blocks, p_task.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_RGTC_RG:
+			CompressBc5(p_task.src, p_task.dst, p_task.blocks, p_task.width);
+			break;
+
+		default:
+			ERR_FAIL_MSG("etcpak: Invalid or unsupported compression format.");
+			break;
+	}
+}
+
+static void _digest_job_queue(void *p_job_queue, uint32_t p_index) {
+	const EtcpakCompressionJobQueue *job_queue = static_cast<const EtcpakCompressionJobQueue *>(p_job_queue);
+	_compress_etcpak_task(job_queue->compress_type, job_queue->tasks[p_index]);
+}
+
 EtcpakType _determine_etc_type(Image::UsedChannels p_channels) {
 	switch (p_channels) {
 		case Image::USED_CHANNELS_L:
@@ -200,7 +270,15 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 	const uint8_t *src_read = r_img->get_data().ptr();
 
 	const int mip_count = has_mipmaps ? Image::get_image_required_mipmaps(width, height, target_format) : 0;
-	Vector<uint32_t> padded_src;
+	// Padded copies must outlive the loop, as the tasks referencing them run afterwards.
+	LocalVector<Vector<uint32_t>> padded_src;
+	padded_src.resize(mip_count + 1);
+
+	// Size of a single compressed 4x4 block, in the uint64_t units etcpak writes.
+	const int block_words = Image::get_image_data_size(4, 4, target_format, false) / sizeof(uint64_t);
+
+	LocalVector<EtcpakCompressionTask> tasks;
+	uint32_t total_blocks = 0;
 
 	for (int i = 0; i < mip_count + 1; i++) {
 		// Get write mip metrics for target image.
@@ -214,7 +292,6 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 		// Block size.
 		dest_mip_w = (dest_mip_w + 3) & ~3;
 		dest_mip_h = (dest_mip_h + 3) & ~3;
-		const uint32_t blocks = dest_mip_w * dest_mip_h / 16;
 
 		// Get mip data from source image for reading.
 		int64_t src_mip_ofs, src_mip_size;
@@ -227,8 +304,8 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 		// Pad textures to nearest block by smearing.
 		if (dest_mip_w != src_mip_w || dest_mip_h != src_mip_h) {
 			// Reserve the buffer for padded image data.
-			padded_src.resize(dest_mip_w * dest_mip_h);
-			uint32_t *ptrw = padded_src.ptrw();
+			padded_src[i].resize(dest_mip_w * dest_mip_h);
+			uint32_t *ptrw = padded_src[i].ptrw();
 
 			int x = 0, y = 0;
 			for (y = 0; y < src_mip_h; y++) {
@@ -250,51 +327,37 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 			}
 
 			// Override the src_mip_read pointer to our temporary Vector.
-			src_mip_read = padded_src.ptr();
+			src_mip_read = padded_src[i].ptr();
 		}
 
-		switch (p_compress_type) {
-			case EtcpakType::ETCPAK_TYPE_ETC1:
-				CompressEtc1RgbDither(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_ETC2:
-				CompressEtc2Rgb(src_mip_read, dest_mip_write, blocks, dest_mip_w, true);
-				break;
+		// Split the mip level into bands of block rows.
+		const int blocks_per_row = dest_mip_w / 4;
+		const int block_rows = dest_mip_h / 4;
 
-			case EtcpakType::ETCPAK_TYPE_ETC2_ALPHA:
-			case EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG:
-				CompressEtc2Rgba(src_mip_read, dest_mip_write, blocks, dest_mip_w, true);
-				break;
+		for (int row = 0; row < block_rows; row += ETCPAK_BLOCK_ROWS_PER_TASK) {
+			const int rows = MIN(ETCPAK_BLOCK_ROWS_PER_TASK, block_rows - row);
 
-			case EtcpakType::ETCPAK_TYPE_ETC2_R:
-				CompressEacR(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
+			EtcpakCompressionTask task;
+			task.src = src_mip_read + row * 4 * dest_mip_w;
+			task.dst = dest_mip_write + row * blocks_per_row * block_words;
+			task.blocks = rows * blocks_per_row;
+			task.width = dest_mip_w;
+			tasks.push_back(task);
 
-			case EtcpakType::ETCPAK_TYPE_ETC2_RG:
-				CompressEacRg(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_DXT1:
-				CompressDxt1Dither(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_DXT5:
-			case EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG:
-				CompressDxt5(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_RGTC_R:
-				CompressBc4(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
+			total_blocks += task.blocks;
+		}
+	}
 
-			case EtcpakType::ETCPAK_TYPE_RGTC_RG:
-				CompressBc5(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
+	if (total_blocks >= ETCPAK_MIN_BLOCKS_FOR_THREADS && tasks.size() > 1) {
+		EtcpakCompressionJobQueue job_queue;
+		job_queue.compress_type = p_compress_type;
+		job_queue.tasks = tasks.ptr();
 
-			default:
-				ERR_FAIL_MSG("etcpak: Invalid or unsupported compression format.");
-				break;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_digest_job_queue, &job_queue, tasks.size(), -1, true, SNAME("etcpak Compress"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (const EtcpakCompressionTask &task : tasks) {
+			_compress_etcpak_task(p_compress_type, task);
 		}
 	}
 
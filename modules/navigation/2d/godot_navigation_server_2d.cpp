@@ -221,6 +221,18 @@ void GodotNavigationServer2D::bake_from_source_geometry_data_async(const Ref<Nav
 #endif // CLIPPER2_ENABLED
 }
 
+Dictionary GodotNavigationServer2D::bake_tiles_from_source_geometry_data(const Ref<NavigationPolygon> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData2D> &p_source_geometry_data, real_t p_tile_size) {
+	ERR_FAIL_COND_V_MSG(!p_navigation_mesh.is_valid(), Dictionary(), "Invalid navigation polygon.");
+	ERR_FAIL_COND_V_MSG(!p_source_geometry_data.is_valid(), Dictionary(), "Invalid NavigationMeshSourceGeometryData2D.");
+
+#ifdef CLIPPER2_ENABLED
+	ERR_FAIL_NULL_V(NavMeshGenerator2D::get_singleton(), Dictionary());
+	return NavMeshGenerator2D::get_singleton()->bake_tiles_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_tile_size);
+#else
+	return Dictionary();
+#endif // CLIPPER2_ENABLED
+}
+
 bool GodotNavigationServer2D::is_baking_navigation_polygon(Ref<NavigationPolygon> p_navigation_polygon) const {
 #ifdef CLIPPER2_ENABLED
 	return NavMeshGenerator2D::get_singleton()->is_baking(p_navigation_polygon);
@@ -287,6 +299,11 @@ Vector2 GodotNavigationServer2D::map_get_random_point(RID p_map, uint32_t p_navi
 	return v3_to_v2(result);
 }
 
+Vector2 GodotNavigationServer2D::map_get_flow_direction(RID p_map, const Vector<Vector2> &p_targets, const Vector2 &p_position, uint32_t p_navigation_layers) const {
+	Vector3 result = NavigationServer3D::get_singleton()->map_get_flow_direction(p_map, vector_v2_to_v3(p_targets), v2_to_v3(p_position), p_navigation_layers);
+	return v3_to_v2(result);
+}
+
 RID FORWARD_0(region_create);
 void FORWARD_2(region_set_enabled, RID, p_region, bool, p_enabled, rid_to_rid, bool_to_bool);
 bool FORWARD_1_C(region_get_enabled, RID, p_region, rid_to_rid);
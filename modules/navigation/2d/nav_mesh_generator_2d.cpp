@@ -61,6 +61,8 @@ HashSet<Ref<NavigationPolygon>> NavMeshGenerator2D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator2D::NavMeshGeneratorTask2D *> NavMeshGenerator2D::generator_tasks;
 RID_Owner<NavMeshGenerator2D::NavMeshGeometryParser2D> NavMeshGenerator2D::generator_parser_owner;
 LocalVector<NavMeshGenerator2D::NavMeshGeometryParser2D *> NavMeshGenerator2D::generator_parsers;
+Mutex NavMeshGenerator2D::generator_tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator2D::NavMeshTileCache2D> NavMeshGenerator2D::generator_tile_caches;
 
 NavMeshGenerator2D *NavMeshGenerator2D::get_singleton() {
 	return singleton;
@@ -136,6 +138,10 @@ void NavMeshGenerator2D::cleanup() {
 	generator_parsers.clear();
 	generator_rid_rwlock.write_unlock();
 
+	generator_tile_cache_mutex.lock();
+	generator_tile_caches.clear();
+	generator_tile_cache_mutex.unlock();
+
 	generator_task_mutex.unlock();
 	baking_navmesh_mutex.unlock();
 }
@@ -791,6 +797,176 @@ static void generator_recursive_process_polytree_items(List<TPPLPoly> &p_tppl_in
 	}
 }
 
+static Clipper2Lib::PathD generator_outline_to_path(const Vector<Vector2> &p_outline) {
+	using namespace Clipper2Lib;
+
+	PathD path;
+	path.reserve(p_outline.size());
+	for (const Vector2 &outline_point : p_outline) {
+		const PointD &point = PointD(outline_point.x, outline_point.y);
+		path.push_back(point);
+	}
+	return path;
+}
+
+static void generator_append_projected_obstruction_paths(const Vector<NavigationMeshSourceGeometryData2D::ProjectedObstruction> &p_projected_obstructions, bool p_carve, Clipper2Lib::PathsD &r_paths) {
+	using namespace Clipper2Lib;
+
+	for (const NavigationMeshSourceGeometryData2D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
+		if (projected_obstruction.carve != p_carve) {
+			continue;
+		}
+		if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 2 != 0) {
+			continue;
+		}
+
+		PathD clip_path;
+		clip_path.reserve(projected_obstruction.vertices.size() / 2);
+		for (int i = 0; i < projected_obstruction.vertices.size() / 2; i++) {
+			const PointD &point = PointD(projected_obstruction.vertices[i * 2], projected_obstruction.vertices[i * 2 + 1]);
+			clip_path.push_back(point);
+		}
+		if (!IsPositive(clip_path)) {
+			std::reverse(clip_path.begin(), clip_path.end());
+		}
+		r_paths.push_back(clip_path);
+	}
+}
+
+// Converts the navigation polygon outlines and the source geometry to clipper paths, clipped to the baking rect.
+static void generator_get_source_paths(const Ref<NavigationPolygon> &p_navigation_mesh, const Vector<Vector<Vector2>> &p_traversable_outlines, const Vector<Vector<Vector2>> &p_obstruction_outlines, const Vector<NavigationMeshSourceGeometryData2D::ProjectedObstruction> &p_projected_obstructions, Clipper2Lib::PathsD &r_traversable_paths, Clipper2Lib::PathsD &r_obstruction_paths, Clipper2Lib::PathsD &r_carve_paths) {
+	using namespace Clipper2Lib;
+
+	int outline_count = p_navigation_mesh->get_outline_count();
+
+	r_traversable_paths.reserve(outline_count + p_traversable_outlines.size());
+	r_obstruction_paths.reserve(p_obstruction_outlines.size());
+
+	for (int i = 0; i < outline_count; i++) {
+		r_traversable_paths.push_back(generator_outline_to_path(p_navigation_mesh->get_outline(i)));
+	}
+
+	for (const Vector<Vector2> &traversable_outline : p_traversable_outlines) {
+		r_traversable_paths.push_back(generator_outline_to_path(traversable_outline));
+	}
+
+	for (const Vector<Vector2> &obstruction_outline : p_obstruction_outlines) {
+		r_obstruction_paths.push_back(generator_outline_to_path(obstruction_outline));
+	}
+
+	generator_append_projected_obstruction_paths(p_projected_obstructions, false, r_obstruction_paths);
+
+	Rect2 baking_rect = p_navigation_mesh->get_baking_rect();
+	if (baking_rect.has_area()) {
+		Vector2 baking_rect_offset = p_navigation_mesh->get_baking_rect_offset();
+
+		const int rect_begin_x = baking_rect.position[0] + baking_rect_offset.x;
+		const int rect_begin_y = baking_rect.position[1] + baking_rect_offset.y;
+		const int rect_end_x = baking_rect.position[0] + baking_rect.size[0] + baking_rect_offset.x;
+		const int rect_end_y = baking_rect.position[1] + baking_rect.size[1] + baking_rect_offset.y;
+
+		RectD clipper_rect = RectD(rect_begin_x, rect_begin_y, rect_end_x, rect_end_y);
+
+		r_traversable_paths = RectClip(clipper_rect, r_traversable_paths);
+		r_obstruction_paths = RectClip(clipper_rect, r_obstruction_paths);
+	}
+
+	generator_append_projected_obstruction_paths(p_projected_obstructions, true, r_carve_paths);
+}
+
+// Subtracts the obstructions from the traversable paths, shrinks the result by the agent radius and cuts out the carving obstructions.
+static Clipper2Lib::PathsD generator_clip_traversable_paths(const Clipper2Lib::PathsD &p_traversable_paths, const Clipper2Lib::PathsD &p_obstruction_paths, const Clipper2Lib::PathsD &p_carve_paths, real_t p_agent_radius) {
+	using namespace Clipper2Lib;
+
+	PathsD path_solution;
+
+	// first merge all traversable polygons according to user specified fill rule
+	PathsD dummy_clip_path;
+	PathsD traversable_polygon_paths = Union(p_traversable_paths, dummy_clip_path, FillRule::NonZero);
+	// merge all obstruction polygons, don't allow holes for what is considered "solid" 2D geometry
+	PathsD obstruction_polygon_paths = Union(p_obstruction_paths, dummy_clip_path, FillRule::NonZero);
+
+	path_solution = Difference(traversable_polygon_paths, obstruction_polygon_paths, FillRule::NonZero);
+
+	if (p_agent_radius > 0.0) {
+		path_solution = InflatePaths(path_solution, -p_agent_radius, JoinType::Miter, EndType::Polygon);
+	}
+
+	if (p_carve_paths.size() > 0) {
+		path_solution = Difference(path_solution, p_carve_paths, FillRule::NonZero);
+	}
+
+	//path_solution = RamerDouglasPeucker(path_solution, 0.025); //
+
+	return path_solution;
+}
+
+// Partitions the outlines into convex polygons. Returns false if the partition failed.
+static bool generator_partition_paths(const Clipper2Lib::PathsD &p_path_solution, Vector<Vector2> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	using namespace Clipper2Lib;
+
+	Vector<Vector<Vector2>> new_baked_outlines;
+
+	for (const PathD &scaled_path : p_path_solution) {
+		Vector<Vector2> polypath;
+		for (const PointD &scaled_point : scaled_path) {
+			polypath.push_back(Vector2(static_cast<real_t>(scaled_point.x), static_cast<real_t>(scaled_point.y)));
+		}
+		new_baked_outlines.push_back(polypath);
+	}
+
+	if (new_baked_outlines.size() == 0) {
+		return true;
+	}
+
+	PathsD polygon_paths;
+	polygon_paths.reserve(new_baked_outlines.size());
+
+	for (const Vector<Vector2> &baked_outline : new_baked_outlines) {
+		polygon_paths.push_back(generator_outline_to_path(baked_outline));
+	}
+
+	ClipType clipper_cliptype = ClipType::Union;
+
+	List<TPPLPoly> tppl_in_polygon, tppl_out_polygon;
+
+	PolyTreeD polytree;
+	ClipperD clipper_D;
+
+	clipper_D.AddSubject(polygon_paths);
+	clipper_D.Execute(clipper_cliptype, FillRule::NonZero, polytree);
+
+	for (size_t i = 0; i < polytree.Count(); i++) {
+		const PolyPathD *polypath_item = polytree[i];
+		generator_recursive_process_polytree_items(tppl_in_polygon, polypath_item);
+	}
+
+	TPPLPartition tpart;
+	if (tpart.ConvexPartition_HM(&tppl_in_polygon, &tppl_out_polygon) == 0) { //failed!
+		return false;
+	}
+
+	HashMap<Vector2, int> points;
+	for (List<TPPLPoly>::Element *I = tppl_out_polygon.front(); I; I = I->next()) {
+		TPPLPoly &tp = I->get();
+
+		Vector<int> new_polygon;
+
+		for (int64_t i = 0; i < tp.GetNumPoints(); i++) {
+			HashMap<Vector2, int>::Iterator E = points.find(tp[i]);
+			if (!E) {
+				E = points.insert(tp[i], r_vertices.size());
+				r_vertices.push_back(tp[i]);
+			}
+			new_polygon.push_back(E->value);
+		}
+
+		r_polygons.push_back(new_polygon);
+	}
+
+	return true;
+}
+
 bool NavMeshGenerator2D::generator_emit_callback(const Callable &p_callback) {
 	ERR_FAIL_COND_V(!p_callback.is_valid(), false);
 
@@ -870,122 +1046,150 @@ void NavMeshGenerator2D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	PathsD traversable_polygon_paths;
 	PathsD obstruction_polygon_paths;
+	PathsD carve_polygon_paths;
 
-	traversable_polygon_paths.reserve(outline_count + traversable_outlines.size());
-	obstruction_polygon_paths.reserve(obstruction_outlines.size());
+	generator_get_source_paths(p_navigation_mesh, traversable_outlines, obstruction_outlines, projected_obstructions, traversable_polygon_paths, obstruction_polygon_paths, carve_polygon_paths);
 
-	for (int i = 0; i < outline_count; i++) {
-		const Vector<Vector2> &traversable_outline = p_navigation_mesh->get_outline(i);
-		PathD subject_path;
-		subject_path.reserve(traversable_outline.size());
-		for (const Vector2 &traversable_point : traversable_outline) {
-			const PointD &point = PointD(traversable_point.x, traversable_point.y);
-			subject_path.push_back(point);
-		}
-		traversable_polygon_paths.push_back(subject_path);
+	PathsD path_solution = generator_clip_traversable_paths(traversable_polygon_paths, obstruction_polygon_paths, carve_polygon_paths, p_navigation_mesh->get_agent_radius());
+
+	Rect2 baking_rect = p_navigation_mesh->get_baking_rect();
+	real_t border_size = p_navigation_mesh->get_border_size();
+	if (baking_rect.has_area() && border_size > 0.0) {
+		Vector2 baking_rect_offset = p_navigation_mesh->get_baking_rect_offset();
+
+		const int rect_begin_x = baking_rect.position[0] + baking_rect_offset.x + border_size;
+		const int rect_begin_y = baking_rect.position[1] + baking_rect_offset.y + border_size;
+		const int rect_end_x = baking_rect.position[0] + baking_rect.size[0] + baking_rect_offset.x - border_size;
+		const int rect_end_y = baking_rect.position[1] + baking_rect.size[1] + baking_rect_offset.y - border_size;
+
+		RectD clipper_rect = RectD(rect_begin_x, rect_begin_y, rect_end_x, rect_end_y);
+
+		path_solution = RectClip(clipper_rect, path_solution);
 	}
 
-	for (const Vector<Vector2> &traversable_outline : traversable_outlines) {
-		PathD subject_path;
-		subject_path.reserve(traversable_outline.size());
-		for (const Vector2 &traversable_point : traversable_outline) {
-			const PointD &point = PointD(traversable_point.x, traversable_point.y);
-			subject_path.push_back(point);
-		}
-		traversable_polygon_paths.push_back(subject_path);
+	Vector<Vector2> new_vertices;
+	Vector<Vector<int>> new_polygons;
+
+	if (!generator_partition_paths(path_solution, new_vertices, new_polygons)) {
+		ERR_PRINT("NavigationPolygon Convex partition failed. Unable to create a valid NavigationMesh from defined polygon outline paths.");
+		p_navigation_mesh->clear();
+		return;
 	}
 
-	for (const Vector<Vector2> &obstruction_outline : obstruction_outlines) {
-		PathD clip_path;
-		clip_path.reserve(obstruction_outline.size());
-		for (const Vector2 &obstruction_point : obstruction_outline) {
-			const PointD &point = PointD(obstruction_point.x, obstruction_point.y);
-			clip_path.push_back(point);
-		}
-		obstruction_polygon_paths.push_back(clip_path);
+	if (new_polygons.is_empty()) {
+		p_navigation_mesh->clear();
+		return;
 	}
 
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData2D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
-			if (projected_obstruction.carve) {
-				continue;
-			}
-			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 2 != 0) {
-				continue;
-			}
+	p_navigation_mesh->set_data(new_vertices, new_polygons);
+}
 
-			PathD clip_path;
-			clip_path.reserve(projected_obstruction.vertices.size() / 2);
-			for (int i = 0; i < projected_obstruction.vertices.size() / 2; i++) {
-				const PointD &point = PointD(projected_obstruction.vertices[i * 2], projected_obstruction.vertices[i * 2 + 1]);
-				clip_path.push_back(point);
-			}
-			if (!IsPositive(clip_path)) {
-				std::reverse(clip_path.begin(), clip_path.end());
-			}
-			obstruction_polygon_paths.push_back(clip_path);
-		}
-	}
+struct NavMeshTileSource2D {
+	Clipper2Lib::PathsD traversable_paths;
+	Clipper2Lib::PathsD obstruction_paths;
+	Clipper2Lib::PathsD carve_paths;
+	real_t agent_radius = 0.0;
+};
 
-	Rect2 baking_rect = p_navigation_mesh->get_baking_rect();
-	if (baking_rect.has_area()) {
-		Vector2 baking_rect_offset = p_navigation_mesh->get_baking_rect_offset();
+struct NavMeshGenerator2D::NavMeshTileBake2D {
+	Vector2i coordinates;
+	const NavMeshTileSource2D *source = nullptr;
 
-		const int rect_begin_x = baking_rect.position[0] + baking_rect_offset.x;
-		const int rect_begin_y = baking_rect.position[1] + baking_rect_offset.y;
-		const int rect_end_x = baking_rect.position[0] + baking_rect.size[0] + baking_rect_offset.x;
-		const int rect_end_y = baking_rect.position[1] + baking_rect.size[1] + baking_rect_offset.y;
+	/// The tile rect grown by a margin, the source geometry of the tile is clipped to it.
+	Clipper2Lib::RectD gather_rect;
+	/// The part of the tile rect the baked polygons are clipped to.
+	Clipper2Lib::RectD clip_rect;
 
-		RectD clipper_rect = RectD(rect_begin_x, rect_begin_y, rect_end_x, rect_end_y);
+	Clipper2Lib::PathsD traversable_paths;
+	Clipper2Lib::PathsD obstruction_paths;
+	Clipper2Lib::PathsD carve_paths;
+	uint32_t source_hash = 0;
+	bool needs_bake = false;
+
+	Vector<Vector2> baked_vertices;
+	Vector<Vector<int>> baked_polygons;
+};
 
-		traversable_polygon_paths = RectClip(clipper_rect, traversable_polygon_paths);
-		obstruction_polygon_paths = RectClip(clipper_rect, obstruction_polygon_paths);
+static uint32_t generator_hash_paths(const Clipper2Lib::PathsD &p_paths, uint32_t p_seed) {
+	uint32_t hash = hash_murmur3_one_32(p_paths.size(), p_seed);
+	for (const Clipper2Lib::PathD &path : p_paths) {
+		hash = hash_murmur3_buffer(path.data(), path.size() * sizeof(Clipper2Lib::PointD), hash);
 	}
+	return hash;
+}
 
-	PathsD path_solution;
+void NavMeshGenerator2D::generator_thread_gather_tile(void *p_arg, uint32_t p_index) {
+	NavMeshTileBake2D &tile_bake = (*static_cast<LocalVector<NavMeshTileBake2D> *>(p_arg))[p_index];
+	const NavMeshTileSource2D *source = tile_bake.source;
 
-	// first merge all traversable polygons according to user specified fill rule
-	PathsD dummy_clip_path;
-	traversable_polygon_paths = Union(traversable_polygon_paths, dummy_clip_path, FillRule::NonZero);
-	// merge all obstruction polygons, don't allow holes for what is considered "solid" 2D geometry
-	obstruction_polygon_paths = Union(obstruction_polygon_paths, dummy_clip_path, FillRule::NonZero);
+	tile_bake.traversable_paths = Clipper2Lib::RectClip(tile_bake.gather_rect, source->traversable_paths);
+	if (tile_bake.traversable_paths.empty()) {
+		return;
+	}
+	tile_bake.obstruction_paths = Clipper2Lib::RectClip(tile_bake.gather_rect, source->obstruction_paths);
+	tile_bake.carve_paths = Clipper2Lib::RectClip(tile_bake.gather_rect, source->carve_paths);
 
-	path_solution = Difference(traversable_polygon_paths, obstruction_polygon_paths, FillRule::NonZero);
+	uint32_t source_hash = generator_hash_paths(tile_bake.traversable_paths, HASH_MURMUR3_SEED);
+	source_hash = generator_hash_paths(tile_bake.obstruction_paths, source_hash);
+	source_hash = generator_hash_paths(tile_bake.carve_paths, source_hash);
+	tile_bake.source_hash = hash_fmix32(source_hash);
+}
 
-	real_t agent_radius_offset = p_navigation_mesh->get_agent_radius();
-	if (agent_radius_offset > 0.0) {
-		path_solution = InflatePaths(path_solution, -agent_radius_offset, JoinType::Miter, EndType::Polygon);
+void NavMeshGenerator2D::generator_thread_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshTileBake2D &tile_bake = (*static_cast<LocalVector<NavMeshTileBake2D> *>(p_arg))[p_index];
+	if (!tile_bake.needs_bake) {
+		return;
 	}
 
-	if (!projected_obstructions.is_empty()) {
-		obstruction_polygon_paths.resize(0);
-		for (const NavigationMeshSourceGeometryData2D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
-			if (!projected_obstruction.carve) {
-				continue;
-			}
-			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 2 != 0) {
-				continue;
-			}
+	Clipper2Lib::PathsD path_solution = generator_clip_traversable_paths(tile_bake.traversable_paths, tile_bake.obstruction_paths, tile_bake.carve_paths, tile_bake.source->agent_radius);
+	path_solution = Clipper2Lib::RectClip(tile_bake.clip_rect, path_solution);
 
-			PathD clip_path;
-			clip_path.reserve(projected_obstruction.vertices.size() / 2);
-			for (int i = 0; i < projected_obstruction.vertices.size() / 2; i++) {
-				const PointD &point = PointD(projected_obstruction.vertices[i * 2], projected_obstruction.vertices[i * 2 + 1]);
-				clip_path.push_back(point);
-			}
-			if (!IsPositive(clip_path)) {
-				std::reverse(clip_path.begin(), clip_path.end());
-			}
-			obstruction_polygon_paths.push_back(clip_path);
-		}
-		if (obstruction_polygon_paths.size() > 0) {
-			path_solution = Difference(path_solution, obstruction_polygon_paths, FillRule::NonZero);
-		}
+	if (!generator_partition_paths(path_solution, tile_bake.baked_vertices, tile_bake.baked_polygons)) {
+		ERR_PRINT(vformat("NavigationPolygon Convex partition failed for tile %s. Unable to create a valid NavigationMesh from defined polygon outline paths.", tile_bake.coordinates));
+		tile_bake.baked_vertices.clear();
+		tile_bake.baked_polygons.clear();
 	}
+}
 
-	//path_solution = RamerDouglasPeucker(path_solution, 0.025); //
+Dictionary NavMeshGenerator2D::bake_tiles_from_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, real_t p_tile_size) {
+	ERR_FAIL_COND_V(!p_navigation_mesh.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(!p_source_geometry_data.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_tile_size <= 0.0, Dictionary(), "The tile size needs to be greater than zero.");
 
-	real_t border_size = p_navigation_mesh->get_border_size();
+	if (is_baking(p_navigation_mesh)) {
+		ERR_FAIL_V_MSG(Dictionary(), "NavigationPolygon is already baking. Wait for current bake to finish.");
+	}
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.insert(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	using namespace Clipper2Lib;
+
+	Vector<Vector<Vector2>> traversable_outlines;
+	Vector<Vector<Vector2>> obstruction_outlines;
+	Vector<NavigationMeshSourceGeometryData2D::ProjectedObstruction> projected_obstructions;
+
+	p_source_geometry_data->get_data(
+			traversable_outlines,
+			obstruction_outlines,
+			projected_obstructions);
+
+	NavMeshTileSource2D tile_source;
+	generator_get_source_paths(p_navigation_mesh, traversable_outlines, obstruction_outlines, projected_obstructions, tile_source.traversable_paths, tile_source.obstruction_paths, tile_source.carve_paths);
+	tile_source.agent_radius = p_navigation_mesh->get_agent_radius();
+
+	// Tiles are aligned on the cell grid, so the tile edges line up with the edge connections of the navigation map.
+	const real_t cell_size = p_navigation_mesh->get_cell_size();
+	const real_t tile_size = cell_size > 0.0 ? MAX(1, (int)Math::round(p_tile_size / cell_size)) * cell_size : p_tile_size;
+	// Shrinking by the agent radius depends on the geometry around the tile, so each tile is baked with a margin.
+	const double margin = tile_source.agent_radius * 2.0 + MAX(cell_size, (real_t)1.0);
+
+	const RectD bounds = GetBounds(tile_source.traversable_paths);
+
+	// Clip the tiles to the baking rect shrunk by the border size, same as a single bake.
+	RectD border_rect = bounds;
+	const Rect2 baking_rect = p_navigation_mesh->get_baking_rect();
+	const real_t border_size = p_navigation_mesh->get_border_size();
 	if (baking_rect.has_area() && border_size > 0.0) {
 		Vector2 baking_rect_offset = p_navigation_mesh->get_baking_rect_offset();
 
@@ -994,82 +1198,135 @@ void NavMeshGenerator2D::generator_bake_from_source_geometry_data(Ref<Navigation
 		const int rect_end_x = baking_rect.position[0] + baking_rect.size[0] + baking_rect_offset.x - border_size;
 		const int rect_end_y = baking_rect.position[1] + baking_rect.size[1] + baking_rect_offset.y - border_size;
 
-		RectD clipper_rect = RectD(rect_begin_x, rect_begin_y, rect_end_x, rect_end_y);
-
-		path_solution = RectClip(clipper_rect, path_solution);
-	}
-
-	Vector<Vector<Vector2>> new_baked_outlines;
+		border_rect = RectD(rect_begin_x, rect_begin_y, rect_end_x, rect_end_y);
+	}
+
+	// Any change of the bake settings invalidates all cached tiles.
+	uint32_t settings_hash = hash_murmur3_one_real(tile_source.agent_radius);
+	settings_hash = hash_murmur3_one_real(tile_size, settings_hash);
+	settings_hash = hash_murmur3_one_real(border_size, settings_hash);
+	settings_hash = hash_murmur3_one_real(baking_rect.position.x, settings_hash);
+	settings_hash = hash_murmur3_one_real(baking_rect.position.y, settings_hash);
+	settings_hash = hash_murmur3_one_real(baking_rect.size.x, settings_hash);
+	settings_hash = hash_murmur3_one_real(baking_rect.size.y, settings_hash);
+	settings_hash = hash_murmur3_one_real(p_navigation_mesh->get_baking_rect_offset().x, settings_hash);
+	settings_hash = hash_murmur3_one_real(p_navigation_mesh->get_baking_rect_offset().y, settings_hash);
+	settings_hash = hash_fmix32(settings_hash);
+
+	LocalVector<NavMeshTileBake2D> tile_bakes;
+
+	if (!bounds.IsEmpty()) {
+		const Vector2i min_tile = Vector2i(Math::floor(bounds.left / tile_size), Math::floor(bounds.top / tile_size));
+		const Vector2i max_tile = Vector2i(Math::floor(bounds.right / tile_size), Math::floor(bounds.bottom / tile_size));
+
+		for (int y = min_tile.y; y <= max_tile.y; y++) {
+			for (int x = min_tile.x; x <= max_tile.x; x++) {
+				const RectD tile_rect = RectD(x * tile_size, y * tile_size, (x + 1) * tile_size, (y + 1) * tile_size);
+				const RectD clip_rect = RectD(MAX(tile_rect.left, border_rect.left), MAX(tile_rect.top, border_rect.top), MIN(tile_rect.right, border_rect.right), MIN(tile_rect.bottom, border_rect.bottom));
+				if (clip_rect.IsEmpty()) {
+					continue;
+				}
 
-	for (const PathD &scaled_path : path_solution) {
-		Vector<Vector2> polypath;
-		for (const PointD &scaled_point : scaled_path) {
-			polypath.push_back(Vector2(static_cast<real_t>(scaled_point.x), static_cast<real_t>(scaled_point.y)));
+				NavMeshTileBake2D tile_bake;
+				tile_bake.coordinates = Vector2i(x, y);
+				tile_bake.source = &tile_source;
+				tile_bake.gather_rect = RectD(tile_rect.left - margin, tile_rect.top - margin, tile_rect.right + margin, tile_rect.bottom + margin);
+				tile_bake.clip_rect = clip_rect;
+				tile_bakes.push_back(tile_bake);
+			}
 		}
-		new_baked_outlines.push_back(polypath);
 	}
 
-	if (new_baked_outlines.size() == 0) {
-		p_navigation_mesh->clear();
-		return;
-	}
-
-	PathsD polygon_paths;
-	polygon_paths.reserve(new_baked_outlines.size());
+	const bool use_group_tasks = use_threads && tile_bakes.size() > 1 && WorkerThreadPool::get_singleton()->get_thread_index() == -1;
 
-	for (const Vector<Vector2> &baked_outline : new_baked_outlines) {
-		PathD polygon_path;
-		for (const Vector2 &baked_outline_point : baked_outline) {
-			const PointD &point = PointD(baked_outline_point.x, baked_outline_point.y);
-			polygon_path.push_back(point);
+	if (use_group_tasks) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator2D::generator_thread_gather_tile, &tile_bakes, tile_bakes.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorGatherTiles2D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tile_bakes.size(); i++) {
+			generator_thread_gather_tile(&tile_bakes, i);
 		}
-		polygon_paths.push_back(polygon_path);
 	}
 
-	ClipType clipper_cliptype = ClipType::Union;
+	const ObjectID navigation_polygon_id = p_navigation_mesh->get_instance_id();
 
-	List<TPPLPoly> tppl_in_polygon, tppl_out_polygon;
-
-	PolyTreeD polytree;
-	ClipperD clipper_D;
+	generator_tile_cache_mutex.lock();
+	{
+		// Forget the tiles of navigation polygons that no longer exist.
+		LocalVector<ObjectID> freed_navigation_polygon_ids;
+		for (const KeyValue<ObjectID, NavMeshTileCache2D> &E : generator_tile_caches) {
+			if (ObjectDB::get_instance(E.key) == nullptr) {
+				freed_navigation_polygon_ids.push_back(E.key);
+			}
+		}
+		for (const ObjectID &freed_navigation_polygon_id : freed_navigation_polygon_ids) {
+			generator_tile_caches.erase(freed_navigation_polygon_id);
+		}
 
-	clipper_D.AddSubject(polygon_paths);
-	clipper_D.Execute(clipper_cliptype, FillRule::NonZero, polytree);
+		NavMeshTileCache2D &tile_cache = generator_tile_caches[navigation_polygon_id];
+		if (tile_cache.settings_hash != settings_hash) {
+			tile_cache.tiles.clear();
+			tile_cache.settings_hash = settings_hash;
+		}
 
-	for (size_t i = 0; i < polytree.Count(); i++) {
-		const PolyPathD *polypath_item = polytree[i];
-		generator_recursive_process_polytree_items(tppl_in_polygon, polypath_item);
+		for (NavMeshTileBake2D &tile_bake : tile_bakes) {
+			if (tile_bake.traversable_paths.empty()) {
+				continue;
+			}
+			const NavMeshTile2D *tile = tile_cache.tiles.getptr(tile_bake.coordinates);
+			tile_bake.needs_bake = tile == nullptr || tile->source_hash != tile_bake.source_hash;
+		}
 	}
+	generator_tile_cache_mutex.unlock();
 
-	TPPLPartition tpart;
-	if (tpart.ConvexPartition_HM(&tppl_in_polygon, &tppl_out_polygon) == 0) { //failed!
-		ERR_PRINT("NavigationPolygon Convex partition failed. Unable to create a valid NavigationMesh from defined polygon outline paths.");
-		p_navigation_mesh->clear();
-		return;
+	if (use_group_tasks) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator2D::generator_thread_bake_tile, &tile_bakes, tile_bakes.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles2D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tile_bakes.size(); i++) {
+			generator_thread_bake_tile(&tile_bakes, i);
+		}
 	}
 
-	Vector<Vector2> new_vertices;
-	Vector<Vector<int>> new_polygons;
+	Dictionary baked_tiles;
 
-	HashMap<Vector2, int> points;
-	for (List<TPPLPoly>::Element *I = tppl_out_polygon.front(); I; I = I->next()) {
-		TPPLPoly &tp = I->get();
+	generator_tile_cache_mutex.lock();
+	{
+		NavMeshTileCache2D &tile_cache = generator_tile_caches[navigation_polygon_id];
 
-		Vector<int> new_polygon;
+		HashMap<Vector2i, NavMeshTile2D> tiles;
+		for (NavMeshTileBake2D &tile_bake : tile_bakes) {
+			if (tile_bake.traversable_paths.empty()) {
+				continue;
+			}
 
-		for (int64_t i = 0; i < tp.GetNumPoints(); i++) {
-			HashMap<Vector2, int>::Iterator E = points.find(tp[i]);
-			if (!E) {
-				E = points.insert(tp[i], new_vertices.size());
-				new_vertices.push_back(tp[i]);
+			NavMeshTile2D tile;
+			if (tile_bake.needs_bake) {
+				tile.source_hash = tile_bake.source_hash;
+				// Tiles without polygons are cached as well, so they are not baked again.
+				if (!tile_bake.baked_polygons.is_empty()) {
+					tile.navigation_polygon = p_navigation_mesh->duplicate();
+					tile.navigation_polygon->clear_outlines();
+					tile.navigation_polygon->set_data(tile_bake.baked_vertices, tile_bake.baked_polygons);
+				}
+			} else {
+				tile = tile_cache.tiles[tile_bake.coordinates];
 			}
-			new_polygon.push_back(E->value);
-		}
 
-		new_polygons.push_back(new_polygon);
+			if (tile.navigation_polygon.is_valid()) {
+				baked_tiles[tile_bake.coordinates] = tile.navigation_polygon;
+			}
+			tiles.insert(tile_bake.coordinates, tile);
+		}
+		tile_cache.tiles = tiles;
 	}
+	generator_tile_cache_mutex.unlock();
 
-	p_navigation_mesh->set_data(new_vertices, new_polygons);
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.erase(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	return baked_tiles;
 }
 
 #endif // CLIPPER2_ENABLED
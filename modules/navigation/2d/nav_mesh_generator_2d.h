@@ -81,6 +81,25 @@ class NavMeshGenerator2D : public Object {
 
 	static HashSet<Ref<NavigationPolygon>> baking_navmeshes;
 
+	struct NavMeshTile2D {
+		/// Hash of the source geometry the tile was baked from.
+		uint32_t source_hash = 0;
+		Ref<NavigationPolygon> navigation_polygon;
+	};
+
+	/// Baked tiles of a navigation polygon, so tiles with unchanged source geometry are not baked again.
+	struct NavMeshTileCache2D {
+		uint32_t settings_hash = 0;
+		HashMap<Vector2i, NavMeshTile2D> tiles;
+	};
+
+	static Mutex generator_tile_cache_mutex;
+	static HashMap<ObjectID, NavMeshTileCache2D> generator_tile_caches;
+
+	struct NavMeshTileBake2D;
+	static void generator_thread_gather_tile(void *p_arg, uint32_t p_index);
+	static void generator_thread_bake_tile(void *p_arg, uint32_t p_index);
+
 	static void generator_parse_geometry_node(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data);
@@ -105,6 +124,7 @@ public:
 	static void bake_from_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationPolygon> p_navigation_polygon);
+	static Dictionary bake_tiles_from_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, real_t p_tile_size);
 
 	static RID source_geometry_parser_create();
 	static void source_geometry_parser_set_callback(RID p_parser, const Callable &p_callback);
@@ -74,6 +74,8 @@ HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
 RID_Owner<NavMeshGenerator3D::NavMeshGeometryParser3D> NavMeshGenerator3D::generator_parser_owner;
 LocalVector<NavMeshGenerator3D::NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
+Mutex NavMeshGenerator3D::generator_tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshTileCache3D> NavMeshGenerator3D::generator_tile_caches;
 
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
@@ -149,6 +151,10 @@ void NavMeshGenerator3D::cleanup() {
 	generator_parsers.clear();
 	generator_rid_rwlock.write_unlock();
 
+	generator_tile_cache_mutex.lock();
+	generator_tile_caches.clear();
+	generator_tile_cache_mutex.unlock();
+
 	generator_task_mutex.unlock();
 	baking_navmesh_mutex.unlock();
 }
@@ -685,13 +691,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
 	// added to keep track of steps, no functionality right now
 	String bake_state = "";
 
@@ -706,102 +705,135 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	rcCalcBounds(verts, nverts, bmin, bmax);
 
 	rcConfig cfg;
-	memset(&cfg, 0, sizeof(cfg));
+	generator_init_config(p_navigation_mesh, cfg);
 
-	cfg.cs = p_navigation_mesh->get_cell_size();
-	cfg.ch = p_navigation_mesh->get_cell_height();
+	cfg.bmin[0] = bmin[0];
+	cfg.bmin[1] = bmin[1];
+	cfg.bmin[2] = bmin[2];
+	cfg.bmax[0] = bmax[0];
+	cfg.bmax[1] = bmax[1];
+	cfg.bmax[2] = bmax[2];
+
+	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	if (baking_aabb.has_volume()) {
+		Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
+		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
+		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
+		cfg.bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
+		cfg.bmax[0] = cfg.bmin[0] + baking_aabb.size[0];
+		cfg.bmax[1] = cfg.bmin[1] + baking_aabb.size[1];
+		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
+	}
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	if (!generator_bake_polygons(p_navigation_mesh, cfg, verts, nverts, tris, ntris, projected_obstructions, nav_vertices, nav_polygons)) {
+		return;
+	}
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+
+	bake_state = "Baking finished."; // step #12
+}
+
+void NavMeshGenerator3D::generator_init_config(const Ref<NavigationMesh> &p_navigation_mesh, rcConfig &r_config) {
+	memset(&r_config, 0, sizeof(r_config));
+
+	r_config.cs = p_navigation_mesh->get_cell_size();
+	r_config.ch = p_navigation_mesh->get_cell_height();
 	if (p_navigation_mesh->get_border_size() > 0.0) {
-		cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
-	}
-	cfg.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
-	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
-	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
+		r_config.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / r_config.cs);
+	}
+	r_config.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
+	r_config.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / r_config.ch);
+	r_config.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / r_config.ch);
+	r_config.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / r_config.cs);
+	r_config.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
+	r_config.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
+	r_config.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
+	r_config.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
+	r_config.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
+	r_config.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
+	r_config.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
 
 	if (p_navigation_mesh->get_border_size() > 0.0 && Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
 		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
+	if (!Math::is_equal_approx((float)r_config.walkableHeight * r_config.ch, p_navigation_mesh->get_agent_height())) {
 		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
+	if (!Math::is_equal_approx((float)r_config.walkableClimb * r_config.ch, p_navigation_mesh->get_agent_max_climb())) {
 		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_navigation_mesh->get_agent_radius())) {
+	if (!Math::is_equal_approx((float)r_config.walkableRadius * r_config.cs, p_navigation_mesh->get_agent_radius())) {
 		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_navigation_mesh->get_edge_max_length())) {
+	if (!Math::is_equal_approx((float)r_config.maxEdgeLen * r_config.cs, p_navigation_mesh->get_edge_max_length())) {
 		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
+	if (!Math::is_equal_approx((float)r_config.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
 		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
+	if (!Math::is_equal_approx((float)r_config.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
 		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
+	if (!Math::is_equal_approx((float)r_config.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
 		WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
 	}
 	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
 		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
 	}
+}
 
-	cfg.bmin[0] = bmin[0];
-	cfg.bmin[1] = bmin[1];
-	cfg.bmin[2] = bmin[2];
-	cfg.bmax[0] = bmax[0];
-	cfg.bmax[1] = bmax[1];
-	cfg.bmax[2] = bmax[2];
+bool NavMeshGenerator3D::generator_bake_polygons(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_config, const float *p_vertices, int p_vertex_count, const int *p_indices, int p_triangle_count, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
 
-	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
-	if (baking_aabb.has_volume()) {
-		Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
-		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
-		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
-		cfg.bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
-		cfg.bmax[0] = cfg.bmin[0] + baking_aabb.size[0];
-		cfg.bmax[1] = cfg.bmin[1] + baking_aabb.size[1];
-		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
-	}
+	// added to keep track of steps, no functionality right now
+	String bake_state = "";
+
+	rcConfig cfg = p_config;
+	const float *verts = p_vertices;
+	const int nverts = p_vertex_count;
+	const int *tris = p_indices;
+	const int ntris = p_triangle_count;
+	const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &projected_obstructions = p_projected_obstructions;
 
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
 	// ~30000000 seems to be around sweetspot where Editor baking breaks
 	if ((cfg.width * cfg.height) > 30000000 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
-		ERR_FAIL_MSG("Baking interrupted."
+		ERR_FAIL_V_MSG(false, "Baking interrupted."
 					 "\nNavigationMesh baking process would likely crash the engine."
 					 "\nSource geometry is suspiciously big for the current Cell Size and Cell Height in the NavMesh Resource bake settings."
 					 "\nIf baking does not crash the engine or fail, the resulting NavigationMesh will create serious pathfinding performance issues."
 					 "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry."
 					 "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
-		return;
+		return false;
 	}
 
 	bake_state = "Creating heightfield..."; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch), false);
 
 	bake_state = "Marking walkable triangles..."; // step #4
 	{
 		Vector<unsigned char> tri_areas;
 		tri_areas.resize(ntris);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
 		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
 		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
@@ -818,8 +850,8 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
@@ -843,7 +875,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Eroding walkable area..."; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf), false);
 
 	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
 	if (!projected_obstructions.is_empty()) {
@@ -865,30 +897,30 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	bake_state = "Partitioning..."; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea), false);
 	}
 
 	bake_state = "Creating contours..."; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset), false);
 
 	bake_state = "Creating polymesh..."; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
@@ -940,7 +972,8 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		}
 	}
 
-	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+	r_vertices = nav_vertices;
+	r_polygons = nav_polygons;
 
 	bake_state = "Cleanup..."; // step #11
 
@@ -949,7 +982,277 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	rcFreePolyMeshDetail(detail_mesh);
 	detail_mesh = nullptr;
 
-	bake_state = "Baking finished."; // step #12
+	return true;
+}
+
+struct NavMeshGenerator3D::NavMeshTileBake3D {
+	Vector2i coordinates;
+	rcConfig config;
+
+	/// Source triangles overlapping the tile and its border, not indexed.
+	LocalVector<float> vertices;
+	LocalVector<int> indices;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
+	uint32_t source_hash = 0;
+	bool needs_bake = true;
+
+	Ref<NavigationMesh> navigation_mesh;
+	Vector<Vector3> baked_vertices;
+	Vector<Vector<int>> baked_polygons;
+};
+
+void NavMeshGenerator3D::generator_thread_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshTileBake3D &tile_bake = (*static_cast<LocalVector<NavMeshTileBake3D> *>(p_arg))[p_index];
+	if (!tile_bake.needs_bake) {
+		return;
+	}
+
+	generator_bake_polygons(tile_bake.navigation_mesh, tile_bake.config, tile_bake.vertices.ptr(), tile_bake.vertices.size() / 3, tile_bake.indices.ptr(), tile_bake.indices.size() / 3, tile_bake.projected_obstructions, tile_bake.baked_vertices, tile_bake.baked_polygons);
+}
+
+Dictionary NavMeshGenerator3D::bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, real_t p_tile_size) {
+	ERR_FAIL_COND_V(!p_navigation_mesh.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(!p_source_geometry_data.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_tile_size <= 0.0, Dictionary(), "The tile size needs to be greater than zero.");
+
+	if (is_baking(p_navigation_mesh)) {
+		ERR_FAIL_V_MSG(Dictionary(), "NavigationMesh is already baking. Wait for current bake to finish.");
+	}
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.insert(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	Vector<float> source_geometry_vertices;
+	Vector<int> source_geometry_indices;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
+
+	p_source_geometry_data->get_data(
+			source_geometry_vertices,
+			source_geometry_indices,
+			projected_obstructions);
+
+	rcConfig cfg;
+	generator_init_config(p_navigation_mesh, cfg);
+
+	// Tiles are aligned on the cell grid and baked with a border, so the polygons of neighboring tiles meet at the tile edges.
+	const int tile_cells = MAX(1, (int)Math::round(p_tile_size / cfg.cs));
+	const float tile_size = tile_cells * cfg.cs;
+	if (cfg.borderSize == 0) {
+		cfg.borderSize = cfg.walkableRadius + 3;
+	}
+	const float border = cfg.borderSize * cfg.cs;
+
+	// Any change of the bake settings invalidates all cached tiles.
+	uint32_t settings_hash = hash_murmur3_buffer(&cfg, sizeof(rcConfig));
+	settings_hash = hash_murmur3_one_32(tile_cells, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles() | (p_navigation_mesh->get_filter_ledge_spans() << 1) | (p_navigation_mesh->get_filter_walkable_low_height_spans() << 2), settings_hash);
+	settings_hash = hash_fmix32(settings_hash);
+
+	LocalVector<NavMeshTileBake3D> tile_bakes;
+
+	const float *verts = source_geometry_vertices.ptr();
+	const int nverts = source_geometry_vertices.size() / 3;
+	const int *tris = source_geometry_indices.ptr();
+	const int ntris = source_geometry_indices.size() / 3;
+
+	if (nverts >= 3 && ntris >= 1) {
+		float bmin[3], bmax[3];
+		rcCalcBounds(verts, nverts, bmin, bmax);
+
+		AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+		const bool use_baking_aabb = baking_aabb.has_volume();
+		if (use_baking_aabb) {
+			Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
+			for (int axis = 0; axis < 3; axis++) {
+				bmin[axis] = baking_aabb.position[axis] + baking_aabb_offset[axis];
+				bmax[axis] = bmin[axis] + baking_aabb.size[axis];
+			}
+		}
+		// The tiles on the edges of the baking AABB are cut to the cells inside it.
+		const float clip_min[2] = { Math::ceil(bmin[0] / cfg.cs) * cfg.cs, Math::ceil(bmin[2] / cfg.cs) * cfg.cs };
+		const float clip_max[2] = { Math::floor(bmax[0] / cfg.cs) * cfg.cs, Math::floor(bmax[2] / cfg.cs) * cfg.cs };
+
+		const Vector2i min_tile = Vector2i(Math::floor(bmin[0] / tile_size), Math::floor(bmin[2] / tile_size));
+		const Vector2i max_tile = Vector2i(Math::floor(bmax[0] / tile_size), Math::floor(bmax[2] / tile_size));
+
+		// Add each triangle to the tiles it overlaps, border included.
+		HashMap<Vector2i, uint32_t> tile_bake_indices;
+		for (int i = 0; i < ntris; i++) {
+			const float *v0 = &verts[tris[i * 3 + 0] * 3];
+			const float *v1 = &verts[tris[i * 3 + 1] * 3];
+			const float *v2 = &verts[tris[i * 3 + 2] * 3];
+
+			const int from_x = MAX(min_tile.x, (int)Math::floor((MIN(v0[0], MIN(v1[0], v2[0])) - border) / tile_size));
+			const int to_x = MIN(max_tile.x, (int)Math::floor((MAX(v0[0], MAX(v1[0], v2[0])) + border) / tile_size));
+			const int from_z = MAX(min_tile.y, (int)Math::floor((MIN(v0[2], MIN(v1[2], v2[2])) - border) / tile_size));
+			const int to_z = MIN(max_tile.y, (int)Math::floor((MAX(v0[2], MAX(v1[2], v2[2])) + border) / tile_size));
+
+			for (int z = from_z; z <= to_z; z++) {
+				for (int x = from_x; x <= to_x; x++) {
+					const Vector2i coordinates = Vector2i(x, z);
+					HashMap<Vector2i, uint32_t>::Iterator E = tile_bake_indices.find(coordinates);
+					if (!E) {
+						float tile_min[2] = { x * tile_size, z * tile_size };
+						float tile_max[2] = { (x + 1) * tile_size, (z + 1) * tile_size };
+						if (use_baking_aabb) {
+							for (int axis = 0; axis < 2; axis++) {
+								tile_min[axis] = MAX(tile_min[axis], clip_min[axis]);
+								tile_max[axis] = MIN(tile_max[axis], clip_max[axis]);
+							}
+							if (tile_min[0] >= tile_max[0] || tile_min[1] >= tile_max[1]) {
+								continue;
+							}
+						}
+
+						E = tile_bake_indices.insert(coordinates, tile_bakes.size());
+						tile_bakes.push_back(NavMeshTileBake3D());
+
+						NavMeshTileBake3D &new_tile_bake = tile_bakes[tile_bakes.size() - 1];
+						new_tile_bake.coordinates = coordinates;
+						new_tile_bake.navigation_mesh = p_navigation_mesh;
+						new_tile_bake.config = cfg;
+						new_tile_bake.config.bmin[0] = tile_min[0] - border;
+						new_tile_bake.config.bmin[1] = bmin[1];
+						new_tile_bake.config.bmin[2] = tile_min[1] - border;
+						new_tile_bake.config.bmax[0] = tile_max[0] + border;
+						new_tile_bake.config.bmax[1] = bmax[1];
+						new_tile_bake.config.bmax[2] = tile_max[1] + border;
+					}
+
+					NavMeshTileBake3D &tile_bake = tile_bakes[E->value];
+					for (const float *v : { v0, v1, v2 }) {
+						tile_bake.indices.push_back(tile_bake.vertices.size() / 3);
+						tile_bake.vertices.push_back(v[0]);
+						tile_bake.vertices.push_back(v[1]);
+						tile_bake.vertices.push_back(v[2]);
+					}
+				}
+			}
+		}
+
+		for (NavMeshTileBake3D &tile_bake : tile_bakes) {
+			if (!use_baking_aabb) {
+				// The height range only depends on the geometry of the tile, snapped to the cell height, so tiles
+				// rebaked after a change elsewhere use the same voxel heights as the cached ones next to them.
+				float min_y = FLT_MAX;
+				float max_y = -FLT_MAX;
+				for (uint32_t i = 1; i < tile_bake.vertices.size(); i += 3) {
+					min_y = MIN(min_y, tile_bake.vertices[i]);
+					max_y = MAX(max_y, tile_bake.vertices[i]);
+				}
+				tile_bake.config.bmin[1] = Math::floor(min_y / cfg.ch) * cfg.ch;
+				tile_bake.config.bmax[1] = MAX(Math::ceil(max_y / cfg.ch) * cfg.ch, tile_bake.config.bmin[1] + cfg.ch);
+			}
+
+			const float *tile_bmin = tile_bake.config.bmin;
+			const float *tile_bmax = tile_bake.config.bmax;
+
+			// The bounds are hashed too, they change with the baking AABB.
+			uint32_t source_hash = hash_murmur3_buffer(tile_bmin, 3 * sizeof(float));
+			source_hash = hash_murmur3_buffer(tile_bmax, 3 * sizeof(float), source_hash);
+			source_hash = hash_murmur3_buffer(tile_bake.vertices.ptr(), tile_bake.vertices.size() * sizeof(float), source_hash);
+			for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+				const Vector<float> &obstruction_vertices = projected_obstruction.vertices;
+				if (obstruction_vertices.is_empty() || obstruction_vertices.size() % 3 != 0) {
+					continue;
+				}
+
+				bool overlaps_x_min = false;
+				bool overlaps_x_max = false;
+				bool overlaps_z_min = false;
+				bool overlaps_z_max = false;
+				for (int i = 0; i < obstruction_vertices.size(); i += 3) {
+					overlaps_x_min |= obstruction_vertices[i] >= tile_bmin[0];
+					overlaps_x_max |= obstruction_vertices[i] <= tile_bmax[0];
+					overlaps_z_min |= obstruction_vertices[i + 2] >= tile_bmin[2];
+					overlaps_z_max |= obstruction_vertices[i + 2] <= tile_bmax[2];
+				}
+				if (!overlaps_x_min || !overlaps_x_max || !overlaps_z_min || !overlaps_z_max) {
+					continue;
+				}
+
+				tile_bake.projected_obstructions.push_back(projected_obstruction);
+				source_hash = hash_murmur3_buffer(obstruction_vertices.ptr(), obstruction_vertices.size() * sizeof(float), source_hash);
+				source_hash = hash_murmur3_one_float(projected_obstruction.elevation, source_hash);
+				source_hash = hash_murmur3_one_float(projected_obstruction.height, source_hash);
+				source_hash = hash_murmur3_one_32(projected_obstruction.carve, source_hash);
+			}
+			tile_bake.source_hash = hash_fmix32(source_hash);
+		}
+	}
+
+	const ObjectID navigation_mesh_id = p_navigation_mesh->get_instance_id();
+
+	generator_tile_cache_mutex.lock();
+	{
+		// Forget the tiles of navigation meshes that no longer exist.
+		LocalVector<ObjectID> freed_navigation_mesh_ids;
+		for (const KeyValue<ObjectID, NavMeshTileCache3D> &E : generator_tile_caches) {
+			if (ObjectDB::get_instance(E.key) == nullptr) {
+				freed_navigation_mesh_ids.push_back(E.key);
+			}
+		}
+		for (const ObjectID &freed_navigation_mesh_id : freed_navigation_mesh_ids) {
+			generator_tile_caches.erase(freed_navigation_mesh_id);
+		}
+
+		NavMeshTileCache3D &tile_cache = generator_tile_caches[navigation_mesh_id];
+		if (tile_cache.settings_hash != settings_hash) {
+			tile_cache.tiles.clear();
+			tile_cache.settings_hash = settings_hash;
+		}
+
+		for (NavMeshTileBake3D &tile_bake : tile_bakes) {
+			const NavMeshTile3D *tile = tile_cache.tiles.getptr(tile_bake.coordinates);
+			tile_bake.needs_bake = tile == nullptr || tile->source_hash != tile_bake.source_hash;
+		}
+	}
+	generator_tile_cache_mutex.unlock();
+
+	if (use_threads && tile_bakes.size() > 1 && WorkerThreadPool::get_singleton()->get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_bake_tile, &tile_bakes, tile_bakes.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < tile_bakes.size(); i++) {
+			generator_thread_bake_tile(&tile_bakes, i);
+		}
+	}
+
+	Dictionary baked_tiles;
+
+	generator_tile_cache_mutex.lock();
+	{
+		NavMeshTileCache3D &tile_cache = generator_tile_caches[navigation_mesh_id];
+
+		HashMap<Vector2i, NavMeshTile3D> tiles;
+		for (NavMeshTileBake3D &tile_bake : tile_bakes) {
+			NavMeshTile3D tile;
+			if (tile_bake.needs_bake) {
+				tile.source_hash = tile_bake.source_hash;
+				// Tiles without polygons are cached as well, so they are not baked again.
+				if (!tile_bake.baked_polygons.is_empty()) {
+					tile.navigation_mesh = p_navigation_mesh->duplicate();
+					tile.navigation_mesh->set_data(tile_bake.baked_vertices, tile_bake.baked_polygons);
+				}
+			} else {
+				tile = tile_cache.tiles[tile_bake.coordinates];
+			}
+
+			if (tile.navigation_mesh.is_valid()) {
+				baked_tiles[tile_bake.coordinates] = tile.navigation_mesh;
+			}
+			tiles.insert(tile_bake.coordinates, tile);
+		}
+		tile_cache.tiles = tiles;
+	}
+	generator_tile_cache_mutex.unlock();
+
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.erase(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	return baked_tiles;
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
@@ -37,10 +37,12 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/templates/rid_owner.h"
 #include "modules/modules_enabled.gen.h" // For csg, gridmap.
+#include "scene/resources/3d/navigation_mesh_source_geometry_data_3d.h"
 
 class Node;
 class NavigationMesh;
-class NavigationMeshSourceGeometryData3D;
+
+struct rcConfig;
 
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
@@ -82,9 +84,29 @@ class NavMeshGenerator3D : public Object {
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
+	struct NavMeshTile3D {
+		/// Hash of the source geometry the tile was baked from.
+		uint32_t source_hash = 0;
+		Ref<NavigationMesh> navigation_mesh;
+	};
+
+	/// Baked tiles of a navigation mesh, so tiles with unchanged source geometry are not baked again.
+	struct NavMeshTileCache3D {
+		uint32_t settings_hash = 0;
+		HashMap<Vector2i, NavMeshTile3D> tiles;
+	};
+
+	static Mutex generator_tile_cache_mutex;
+	static HashMap<ObjectID, NavMeshTileCache3D> generator_tile_caches;
+
+	struct NavMeshTileBake3D;
+	static void generator_thread_bake_tile(void *p_arg, uint32_t p_index);
+
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static void generator_init_config(const Ref<NavigationMesh> &p_navigation_mesh, rcConfig &r_config);
+	static bool generator_bake_polygons(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_config, const float *p_vertices, int p_vertex_count, const int *p_indices, int p_triangle_count, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
 
 	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
 	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
@@ -110,6 +132,7 @@ public:
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationMesh> p_navigation_mesh);
+	static Dictionary bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, real_t p_tile_size);
 
 	static RID source_geometry_parser_create();
 	static void source_geometry_parser_set_callback(RID p_parser, const Callable &p_callback);
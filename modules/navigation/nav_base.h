@@ -45,6 +45,7 @@ protected:
 	real_t travel_cost = 1.0;
 	ObjectID owner_id;
 	NavigationUtilities::PathSegmentType type;
+	bool query_parameters_dirty = false;
 
 public:
 	NavigationUtilities::PathSegmentType get_type() const { return type; }
@@ -52,15 +53,34 @@ public:
 	virtual void set_use_edge_connections(bool p_enabled) {}
 	virtual bool get_use_edge_connections() const { return false; }
 
-	void set_navigation_layers(uint32_t p_navigation_layers) { navigation_layers = p_navigation_layers; }
+	void set_navigation_layers(uint32_t p_navigation_layers) {
+		query_parameters_dirty |= navigation_layers != p_navigation_layers;
+		navigation_layers = p_navigation_layers;
+	}
 	uint32_t get_navigation_layers() const { return navigation_layers; }
 
-	void set_enter_cost(real_t p_enter_cost) { enter_cost = MAX(p_enter_cost, 0.0); }
+	void set_enter_cost(real_t p_enter_cost) {
+		p_enter_cost = MAX(p_enter_cost, 0.0);
+		query_parameters_dirty |= enter_cost != p_enter_cost;
+		enter_cost = p_enter_cost;
+	}
 	real_t get_enter_cost() const { return enter_cost; }
 
-	void set_travel_cost(real_t p_travel_cost) { travel_cost = MAX(p_travel_cost, 0.0); }
+	void set_travel_cost(real_t p_travel_cost) {
+		p_travel_cost = MAX(p_travel_cost, 0.0);
+		query_parameters_dirty |= travel_cost != p_travel_cost;
+		travel_cost = p_travel_cost;
+	}
 	real_t get_travel_cost() const { return travel_cost; }
 
+	// Whether the layers or costs changed since the last call, so results the map cached with them are outdated.
+	bool check_query_parameters_dirty() {
+		const bool was_dirty = query_parameters_dirty;
+
+		query_parameters_dirty = false;
+		return was_dirty;
+	}
+
 	void set_owner_id(ObjectID p_owner_id) { owner_id = p_owner_id; }
 	ObjectID get_owner_id() const { return owner_id; }
 
@@ -37,6 +37,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
 
 #include <Obstacle2d.h>
 
@@ -63,6 +64,8 @@
 #define NAVMAP_ITERATION_ZERO_ERROR_MSG()
 #endif // DEBUG_ENABLED
 
+thread_local NavMap::PathQueryContext NavMap::path_query_context;
+
 void NavMap::set_up(Vector3 p_up) {
 	if (up == p_up) {
 		return;
@@ -135,7 +138,7 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
-Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const {
+Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, bool p_use_hierarchy) const {
 	RWLockRead read_lock(map_rwlock);
 	if (iteration_id == 0) {
 		NAVMAP_ITERATION_ZERO_ERROR_MSG();
@@ -158,35 +161,16 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
+	// Only consider polygons in regions with compatible layers.
+	const int64_t begin_poly_index = _get_closest_polygon(p_origin, true, p_navigation_layers, FLT_MAX, begin_point);
+	const int64_t end_poly_index = _get_closest_polygon(p_destination, true, p_navigation_layers, FLT_MAX, end_point);
+	if (begin_poly_index != -1) {
+		begin_poly = &polygons[begin_poly_index];
+	}
+	if (end_poly_index != -1) {
+		end_poly = &polygons[end_poly_index];
 	}
 
 	// Check for trivial cases
@@ -219,9 +203,15 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	// Reuse the scratch data of previous queries made on this thread.
+	PathQueryContext &context = path_query_context;
+	context.begin(polygons.size() + link_polygons.size());
+
+	// With the hierarchy, only search the polygons of the clusters on the route found between the portals.
+	bool use_corridor = p_use_hierarchy && _find_hierarchy_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, context);
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	LocalVector<gd::NavigationPoly> &navigation_polys = context.navigation_polys;
 
 	// Add the start polygon to the reachable navigation polygons.
 	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
@@ -229,10 +219,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	begin_navigation_poly.entry = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
-	navigation_polys.push_back(begin_navigation_poly);
+	context.add_navigation_poly(begin_navigation_poly);
 
 	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
+	LocalVector<uint32_t> &to_visit = context.to_visit;
 	to_visit.push_back(0);
 
 	// This is an implementation of the A* algorithm.
@@ -256,6 +246,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				if (use_corridor && !context.corridor_clusters[hierarchy_polygon_clusters[connection.polygon->id]]) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -269,7 +263,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				int64_t already_visited_polygon_index = context.find_navigation_poly(connection.polygon);
 
 				if (already_visited_polygon_index != -1) {
 					// Polygon already visited, check if we can reduce the travel cost.
@@ -292,7 +286,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
 					new_navigation_poly.traveled_distance = new_distance;
 					new_navigation_poly.entry = new_entry;
-					navigation_polys.push_back(new_navigation_poly);
+					context.add_navigation_poly(new_navigation_poly);
 
 					// Add the neighbor polygon to the polygons to visit.
 					to_visit.push_back(navigation_polys.size() - 1);
@@ -304,6 +298,23 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		to_visit.erase(least_cost_id);
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
+		if (to_visit.size() == 0 && use_corridor) {
+			// Not within the corridor at least, so search the whole map before giving up.
+			use_corridor = false;
+
+			gd::NavigationPoly np = navigation_polys[0];
+			context.begin(polygons.size() + link_polygons.size());
+			context.add_navigation_poly(np);
+			to_visit.push_back(0);
+			least_cost_id = 0;
+			prev_least_cost_id = -1;
+
+			reachable_end = nullptr;
+			reachable_d = FLT_MAX;
+
+			continue;
+		}
+
 		if (to_visit.size() == 0) {
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
@@ -368,9 +379,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 			// Reset open and navigation_polys
 			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			to_visit.clear();
+			context.begin(polygons.size() + link_polygons.size());
+			context.add_navigation_poly(np);
 			to_visit.push_back(0);
 			least_cost_id = 0;
 			prev_least_cost_id = -1;
@@ -383,8 +393,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		// Find the polygon with the minimum cost from the list of polygons to visit.
 		least_cost_id = -1;
 		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
+		for (const uint32_t navigation_poly_index : to_visit) {
+			gd::NavigationPoly *np = &navigation_polys[navigation_poly_index];
 			real_t cost = np->traveled_distance;
 			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
 			if (cost < least_cost) {
@@ -607,28 +617,84 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 		return Vector3();
 	}
 
-	bool use_collision = p_use_collision;
 	Vector3 closest_point;
 	real_t closest_point_d = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
+	if (polygon_bvh.is_empty()) {
+		return closest_point;
+	}
+
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+
+	uint32_t stack[64];
+	uint32_t stack_size = 0;
+
+	// Intersections with the segment take precedence, the closest one to its start wins.
+	bool collided = false;
+	stack[stack_size++] = 0;
+	while (stack_size > 0) {
+		const uint32_t node_index = stack[--stack_size];
+		const PolygonBVHNode &node = polygon_bvh[node_index];
+		if (!node.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.count == 0) {
+			stack[stack_size++] = node.index;
+			stack[stack_size++] = node_index + 1;
+			continue;
+		}
+
+		for (uint32_t i = node.index; i < node.index + node.count; i++) {
+			const gd::Polygon &p = polygons[polygon_bvh_indices[i]];
+			for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				Vector3 inters;
+				if (f.intersects_segment(p_from, p_to, &inters)) {
+					const real_t d = p_from.distance_to(inters);
+					if (closest_point_d > d) {
+						closest_point = inters;
+						closest_point_d = d;
+						collided = true;
+					}
 				}
 			}
-			// If segment does not itersect face, check the distance from segment's endpoints.
-			else if (!use_collision) {
+		}
+	}
+
+	if (collided || p_use_collision) {
+		return closest_point;
+	}
+
+	// Otherwise find the point of the map closest to the segment. The distance between a node
+	// and the bounds of the segment never exceeds the distance to the segment itself.
+	stack[stack_size++] = 0;
+	while (stack_size > 0) {
+		const uint32_t node_index = stack[--stack_size];
+		const PolygonBVHNode &node = polygon_bvh[node_index];
+		real_t node_d_squared = 0.0;
+		for (int axis = 0; axis < 3; axis++) {
+			const real_t gap = MAX(MAX(node.aabb.position[axis] - segment_aabb.get_end()[axis], segment_aabb.position[axis] - node.aabb.get_end()[axis]), (real_t)0.0);
+			node_d_squared += gap * gap;
+		}
+		if (closest_point_d != FLT_MAX && node_d_squared >= closest_point_d * closest_point_d) {
+			continue;
+		}
+
+		if (node.count == 0) {
+			stack[stack_size++] = node.index;
+			stack[stack_size++] = node_index + 1;
+			continue;
+		}
+
+		for (uint32_t i = node.index; i < node.index + node.count; i++) {
+			const gd::Polygon &p = polygons[polygon_bvh_indices[i]];
+
+			// For each face check the distance from segment's endpoints.
+			for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+
 				const Vector3 p_from_closest = f.get_closest_point_to(p_from);
 				const real_t d_p_from = p_from.distance_to(p_from_closest);
 				if (closest_point_d > d_p_from) {
@@ -643,9 +709,8 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 					closest_point_d = d_p_to;
 				}
 			}
-		}
-		// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
-		if (!use_collision) {
+
+			// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
 			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
 				Vector3 a, b;
 
@@ -703,21 +768,14 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	RWLockRead read_lock(map_rwlock);
 
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
-
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+
+	Vector3 closest_point;
+	Face3 closest_face;
+	const int64_t closest_poly_index = _get_closest_polygon(p_point, false, 0, FLT_MAX, closest_point, &closest_face);
+	if (closest_poly_index != -1) {
+		result.point = closest_point;
+		result.normal = closest_face.get_plane().normal;
+		result.owner = polygons[closest_poly_index].owner->get_self();
 	}
 
 	return result;
@@ -805,12 +863,14 @@ void NavMap::set_agent_as_controlled(NavAgent *agent) {
 		int64_t agent_3d_index = active_3d_avoidance_agents.find(agent);
 		if (agent_3d_index < 0) {
 			active_3d_avoidance_agents.push_back(agent);
+			avoidance_grid_3d.dirty = true;
 			agents_dirty = true;
 		}
 	} else {
 		int64_t agent_2d_index = active_2d_avoidance_agents.find(agent);
 		if (agent_2d_index < 0) {
 			active_2d_avoidance_agents.push_back(agent);
+			avoidance_grid_2d.dirty = true;
 			agents_dirty = true;
 		}
 	}
@@ -820,11 +880,13 @@ void NavMap::remove_agent_as_controlled(NavAgent *agent) {
 	int64_t agent_3d_index = active_3d_avoidance_agents.find(agent);
 	if (agent_3d_index >= 0) {
 		active_3d_avoidance_agents.remove_at_unordered(agent_3d_index);
+		avoidance_grid_3d.dirty = true;
 		agents_dirty = true;
 	}
 	int64_t agent_2d_index = active_2d_avoidance_agents.find(agent);
 	if (agent_2d_index >= 0) {
 		active_2d_avoidance_agents.remove_at_unordered(agent_2d_index);
+		avoidance_grid_2d.dirty = true;
 		agents_dirty = true;
 	}
 }
@@ -895,6 +957,222 @@ Vector3 NavMap::get_random_point(uint32_t p_navigation_layers, bool p_uniformly)
 	}
 }
 
+Vector3 NavMap::get_flow_direction(const Vector<Vector3> &p_targets, const Vector3 &p_position, uint32_t p_navigation_layers) const {
+	RWLockRead read_lock(map_rwlock);
+	if (iteration_id == 0) {
+		NAVMAP_ITERATION_ZERO_ERROR_MSG();
+		return Vector3();
+	}
+
+	Vector3 point;
+	const int64_t polygon_index = _get_closest_polygon(p_position, true, p_navigation_layers, FLT_MAX, point);
+	if (polygon_index == -1) {
+		return Vector3();
+	}
+
+	LocalVector<uint32_t> target_polygons;
+	Vector3 closest_target_point;
+	real_t closest_target_distance_squared = FLT_MAX;
+	for (const Vector3 &target : p_targets) {
+		Vector3 target_point;
+		const int64_t target_polygon_index = _get_closest_polygon(target, true, p_navigation_layers, FLT_MAX, target_point);
+		if (target_polygon_index == -1) {
+			continue;
+		}
+
+		// Targets in the same polygon can be reached directly.
+		if (target_polygon_index == polygon_index && point.distance_squared_to(target_point) < closest_target_distance_squared) {
+			closest_target_point = target_point;
+			closest_target_distance_squared = point.distance_squared_to(target_point);
+		}
+		if (!target_polygons.has(target_polygon_index)) {
+			target_polygons.push_back(target_polygon_index);
+		}
+	}
+
+	if (closest_target_distance_squared != FLT_MAX) {
+		return (closest_target_point - point).normalized();
+	}
+	if (target_polygons.is_empty()) {
+		return Vector3();
+	}
+	target_polygons.sort();
+
+	{
+		RWLockRead flow_field_read_lock(flow_field_rwlock);
+		const int64_t flow_field_index = _find_flow_field(target_polygons, p_navigation_layers);
+		if (flow_field_index != -1) {
+			return _get_flow_field_direction(flow_fields[flow_field_index], polygon_index, point);
+		}
+	}
+
+	// Compute the flow field while holding the write lock, so the agents moving to the same targets wait for it instead of computing it too.
+	RWLockWrite flow_field_write_lock(flow_field_rwlock);
+	int64_t flow_field_index = _find_flow_field(target_polygons, p_navigation_layers);
+	if (flow_field_index == -1) {
+		if (flow_fields.size() < MAX_FLOW_FIELDS) {
+			flow_field_index = flow_fields.size();
+			flow_fields.resize(flow_fields.size() + 1);
+		} else {
+			flow_field_index = flow_field_next_index;
+			flow_field_next_index = (flow_field_next_index + 1) % MAX_FLOW_FIELDS;
+		}
+
+		FlowField &flow_field = flow_fields[flow_field_index];
+		flow_field.target_polygons = target_polygons;
+		flow_field.navigation_layers = p_navigation_layers;
+		_compute_flow_field(flow_field);
+	}
+	return _get_flow_field_direction(flow_fields[flow_field_index], polygon_index, point);
+}
+
+int64_t NavMap::_find_flow_field(const LocalVector<uint32_t> &p_target_polygons, uint32_t p_navigation_layers) const {
+	for (uint32_t i = 0; i < flow_fields.size(); i++) {
+		const FlowField &flow_field = flow_fields[i];
+		if (flow_field.navigation_layers != p_navigation_layers || flow_field.target_polygons.size() != p_target_polygons.size()) {
+			continue;
+		}
+		bool same_targets = true;
+		for (uint32_t j = 0; j < p_target_polygons.size(); j++) {
+			if (flow_field.target_polygons[j] != p_target_polygons[j]) {
+				same_targets = false;
+				break;
+			}
+		}
+		if (same_targets) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void NavMap::_compute_flow_field(FlowField &r_flow_field) const {
+	const uint32_t polygon_count = polygons.size() + link_polygons.size();
+	const uint32_t navigation_layers = r_flow_field.navigation_layers;
+
+	r_flow_field.distances.resize(polygon_count);
+	r_flow_field.next_polygons.resize(polygon_count);
+	r_flow_field.pathway_starts.resize(polygon_count);
+	r_flow_field.pathway_ends.resize(polygon_count);
+
+	LocalVector<Vector3> polygon_centers;
+	polygon_centers.resize(polygon_count);
+	// Number of connections leading into each polygon, then the offset of its first one.
+	LocalVector<uint32_t> incoming_offsets;
+	incoming_offsets.resize(polygon_count + 1);
+	memset(incoming_offsets.ptr(), 0, sizeof(uint32_t) * incoming_offsets.size());
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const gd::Polygon &polygon = _get_polygon(polygon_id);
+		r_flow_field.distances[polygon_id] = FLT_MAX;
+		r_flow_field.next_polygons[polygon_id] = -1;
+
+		Vector3 center;
+		for (const gd::Point &point : polygon.points) {
+			center += point.pos;
+		}
+		polygon_centers[polygon_id] = polygon.points.is_empty() ? center : center / polygon.points.size();
+
+		if ((polygon.owner->get_navigation_layers() & navigation_layers) == 0) {
+			continue;
+		}
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				if ((connection.polygon->owner->get_navigation_layers() & navigation_layers) != 0) {
+					incoming_offsets[connection.polygon->id + 1]++;
+				}
+			}
+		}
+	}
+
+	// The field is computed from the targets outwards, so the connections are followed backwards.
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		incoming_offsets[polygon_id + 1] += incoming_offsets[polygon_id];
+	}
+	LocalVector<Pair<uint32_t, const gd::Edge::Connection *>> incoming_connections;
+	incoming_connections.resize(incoming_offsets[polygon_count]);
+	LocalVector<uint32_t> incoming_counts;
+	incoming_counts.resize(polygon_count);
+	memset(incoming_counts.ptr(), 0, sizeof(uint32_t) * polygon_count);
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const gd::Polygon &polygon = _get_polygon(polygon_id);
+		if ((polygon.owner->get_navigation_layers() & navigation_layers) == 0) {
+			continue;
+		}
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				if ((connection.polygon->owner->get_navigation_layers() & navigation_layers) != 0) {
+					const uint32_t neighbor_id = connection.polygon->id;
+					incoming_connections[incoming_offsets[neighbor_id] + incoming_counts[neighbor_id]++] = Pair<uint32_t, const gd::Edge::Connection *>(polygon_id, &connection);
+				}
+			}
+		}
+	}
+
+	// Dijkstra over the polygon centers, from all the target polygons at once.
+	LocalVector<HierarchyHeapEntry> heap;
+	SortArray<HierarchyHeapEntry, HierarchyHeapCompare> heap_sort;
+	for (const uint32_t polygon_id : r_flow_field.target_polygons) {
+		r_flow_field.distances[polygon_id] = 0.0;
+		heap.push_back({ 0.0, 0.0, polygon_id });
+		heap_sort.push_heap(0, heap.size() - 1, 0, heap[heap.size() - 1], heap.ptr());
+	}
+
+	while (!heap.is_empty()) {
+		heap_sort.pop_heap(0, heap.size(), heap.ptr());
+		const HierarchyHeapEntry current = heap[heap.size() - 1];
+		heap.resize(heap.size() - 1);
+		if (current.cost > r_flow_field.distances[current.index]) {
+			continue;
+		}
+
+		const gd::Polygon &polygon = _get_polygon(current.index);
+		for (uint32_t i = incoming_offsets[current.index]; i < incoming_offsets[current.index + 1]; i++) {
+			const uint32_t source_id = incoming_connections[i].first;
+			const gd::Edge::Connection *connection = incoming_connections[i].second;
+			const gd::Polygon &source_polygon = _get_polygon(source_id);
+
+			const Vector3 gateway = (connection->pathway_start + connection->pathway_end) * 0.5;
+			real_t distance = current.cost + polygon_centers[source_id].distance_to(gateway) * source_polygon.owner->get_travel_cost() + gateway.distance_to(polygon_centers[current.index]) * polygon.owner->get_travel_cost();
+			if (source_polygon.owner != polygon.owner) {
+				distance += polygon.owner->get_enter_cost();
+			}
+
+			if (distance < r_flow_field.distances[source_id]) {
+				r_flow_field.distances[source_id] = distance;
+				r_flow_field.next_polygons[source_id] = current.index;
+				r_flow_field.pathway_starts[source_id] = connection->pathway_start;
+				r_flow_field.pathway_ends[source_id] = connection->pathway_end;
+				heap.push_back({ distance, distance, source_id });
+				heap_sort.push_heap(0, heap.size() - 1, 0, heap[heap.size() - 1], heap.ptr());
+			}
+		}
+	}
+}
+
+Vector3 NavMap::_get_flow_field_direction(const FlowField &p_flow_field, uint32_t p_polygon_id, const Vector3 &p_point) const {
+	const int64_t next_polygon_id = p_flow_field.next_polygons[p_polygon_id];
+	if (next_polygon_id == -1) {
+		// The targets can not be reached from this polygon.
+		return Vector3();
+	}
+
+	const Vector3 pathway[2] = { p_flow_field.pathway_starts[p_polygon_id], p_flow_field.pathway_ends[p_polygon_id] };
+	Vector3 direction = Geometry3D::get_closest_point_to_segment(p_point, pathway) - p_point;
+	if (direction.length_squared() < CMP_EPSILON2) {
+		// Already on the gateway, so head into the next polygon.
+		const gd::Polygon &next_polygon = _get_polygon(next_polygon_id);
+		Vector3 center;
+		for (const gd::Point &point : next_polygon.points) {
+			center += point.pos;
+		}
+		if (!next_polygon.points.is_empty()) {
+			direction = center / next_polygon.points.size() - p_point;
+		}
+	}
+	return direction.normalized();
+}
+
 void NavMap::sync() {
 	RWLockWrite write_lock(map_rwlock);
 
@@ -917,16 +1195,25 @@ void NavMap::sync() {
 		regenerate_links = true;
 	}
 
+	// Owners with modified polygons, their hierarchy costs have to be recomputed.
+	HashSet<const NavBase *> changed_owners;
+	// Flow fields bake in the layers and costs of the owners.
+	bool clear_flow_fields = false;
+
 	for (NavRegion *region : regions) {
 		if (region->sync()) {
 			regenerate_links = true;
+			changed_owners.insert(region);
 		}
+		clear_flow_fields |= region->check_query_parameters_dirty();
 	}
 
 	for (NavLink *link : links) {
 		if (link->check_dirty()) {
 			regenerate_links = true;
+			changed_owners.insert(link);
 		}
+		clear_flow_fields |= link->check_query_parameters_dirty();
 	}
 
 	if (regenerate_links) {
@@ -951,7 +1238,7 @@ void NavMap::sync() {
 		}
 		polygons.resize(count);
 
-		// Copy all region polygons in the map.
+		// Copy all region polygons in the map, and connect the edges already merged by each region.
 		count = 0;
 		for (const NavRegion *region : regions) {
 			if (!region->get_enabled()) {
@@ -961,15 +1248,50 @@ void NavMap::sync() {
 			for (uint32_t n = 0; n < polygons_source.size(); n++) {
 				polygons[count + n] = polygons_source[n];
 			}
+
+			for (const NavRegion::EdgeMerge &edge_merge : region->get_edge_merges()) {
+				gd::Polygon &polygon_a = polygons[count + edge_merge.polygon_a];
+				gd::Polygon &polygon_b = polygons[count + edge_merge.polygon_b];
+
+				gd::Edge::Connection connection_a;
+				connection_a.polygon = &polygon_a;
+				connection_a.edge = edge_merge.edge_a;
+				connection_a.pathway_start = polygon_a.points[edge_merge.edge_a].pos;
+				connection_a.pathway_end = polygon_a.points[(edge_merge.edge_a + 1) % polygon_a.points.size()].pos;
+
+				gd::Edge::Connection connection_b;
+				connection_b.polygon = &polygon_b;
+				connection_b.edge = edge_merge.edge_b;
+				connection_b.pathway_start = polygon_b.points[edge_merge.edge_b].pos;
+				connection_b.pathway_end = polygon_b.points[(edge_merge.edge_b + 1) % polygon_b.points.size()].pos;
+
+				polygon_a.edges[edge_merge.edge_a].connections.push_back(connection_b);
+				polygon_b.edges[edge_merge.edge_b].connections.push_back(connection_a);
+			}
+			_new_pm_edge_count += region->get_edge_merges().size();
+			_new_pm_edge_merge_count += region->get_edge_merges().size();
+
 			count += region->get_polygons().size();
 		}
 
 		_new_pm_polygon_count = polygons.size();
 
-		// Group all edges per key.
+		for (uint32_t i = 0; i < polygons.size(); i++) {
+			polygons[i].id = i;
+		}
+
+		_update_polygon_bvh();
+
+		// Group the border edges of the regions per key.
 		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
+		count = 0;
+		for (const NavRegion *region : regions) {
+			if (!region->get_enabled()) {
+				continue;
+			}
+			for (const NavRegion::BorderEdge &border_edge : region->get_border_edges()) {
+				gd::Polygon &poly = polygons[count + border_edge.polygon];
+				const uint32_t p = border_edge.edge;
 				int next_point = (p + 1) % poly.points.size();
 				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
 
@@ -991,6 +1313,7 @@ void NavMap::sync() {
 					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
 				}
 			}
+			count += region->get_polygons().size();
 		}
 
 		Vector<gd::Edge::Connection> free_edges;
@@ -1020,12 +1343,51 @@ void NavMap::sync() {
 		// connection, integration and path finding.
 		_new_pm_edge_free_count = free_edges.size();
 
+		// Sort the free edges along the x axis, so each edge is only compared with the edges close to it.
+		LocalVector<FreeEdgeExtent> free_edges_by_x;
+		free_edges_by_x.resize(free_edges.size());
+		real_t max_free_edge_width = 0.0;
+		for (int i = 0; i < free_edges.size(); i++) {
+			const gd::Edge::Connection &free_edge = free_edges[i];
+			const real_t x1 = free_edge.polygon->points[free_edge.edge].pos.x;
+			const real_t x2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos.x;
+			free_edges_by_x[i].min_x = MIN(x1, x2);
+			free_edges_by_x[i].max_x = MAX(x1, x2);
+			free_edges_by_x[i].index = i;
+			max_free_edge_width = MAX(max_free_edge_width, free_edges_by_x[i].max_x - free_edges_by_x[i].min_x);
+		}
+		free_edges_by_x.sort();
+
+		LocalVector<int> near_free_edges;
+
 		for (int i = 0; i < free_edges.size(); i++) {
 			const gd::Edge::Connection &free_edge = free_edges[i];
 			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
 			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
 
-			for (int j = 0; j < free_edges.size(); j++) {
+			// Edges further than the margin on the x axis can't be connected.
+			const real_t search_min_x = MIN(edge_p1.x, edge_p2.x) - edge_connection_margin;
+			const real_t search_max_x = MAX(edge_p1.x, edge_p2.x) + edge_connection_margin;
+			uint32_t first = 0;
+			uint32_t last = free_edges_by_x.size();
+			while (first < last) {
+				const uint32_t middle = (first + last) / 2;
+				if (free_edges_by_x[middle].min_x < search_min_x - max_free_edge_width) {
+					first = middle + 1;
+				} else {
+					last = middle;
+				}
+			}
+			near_free_edges.clear();
+			for (uint32_t k = first; k < free_edges_by_x.size() && free_edges_by_x[k].min_x <= search_max_x; k++) {
+				if (free_edges_by_x[k].max_x >= search_min_x) {
+					near_free_edges.push_back(free_edges_by_x[k].index);
+				}
+			}
+			// Keep connecting the edges in the order they were found.
+			near_free_edges.sort();
+
+			for (const int j : near_free_edges) {
 				const gd::Edge::Connection &other_edge = free_edges[j];
 				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
 					continue;
@@ -1089,53 +1451,28 @@ void NavMap::sync() {
 			const Vector3 end = link->get_end_position();
 
 			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
 			Vector3 closest_start_point;
 
 			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
 			Vector3 closest_end_point;
 
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
+			// Pick the polygons closest to the start and end points, within the search radius.
+			const real_t link_connection_radius_squared = link_connection_radius * link_connection_radius;
+			const int64_t closest_start_index = _get_closest_polygon(start, false, 0, link_connection_radius_squared, closest_start_point);
+			if (closest_start_index != -1) {
+				closest_start_polygon = &polygons[closest_start_index];
 			}
-
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+			const int64_t closest_end_index = _get_closest_polygon(end, false, 0, link_connection_radius_squared, closest_end_point);
+			if (closest_end_index != -1) {
+				closest_end_polygon = &polygons[closest_end_index];
 			}
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
 			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
+				gd::Polygon &new_polygon = link_polygons[link_poly_idx];
 				new_polygon.owner = link;
+				new_polygon.id = polygons.size() + link_poly_idx;
+				link_poly_idx++;
 
 				new_polygon.edges.clear();
 				new_polygon.edges.resize(4);
@@ -1184,10 +1521,25 @@ void NavMap::sync() {
 			}
 		}
 
+		// Drop the polygons left over from disabled links or links without polygons in range.
+		link_polygons.resize(link_poly_idx);
+
+		_update_hierarchy(changed_owners);
+
+		// Flow fields reference the polygons of the previous iteration.
+		clear_flow_fields = true;
+
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
 		iteration_id = iteration_id % UINT32_MAX + 1;
 	}
 
+	if (clear_flow_fields) {
+		flow_field_rwlock.write_lock();
+		flow_fields.clear();
+		flow_field_next_index = 0;
+		flow_field_rwlock.write_unlock();
+	}
+
 	// Do we have modified obstacle positions?
 	for (NavObstacle *obstacle : obstacles) {
 		if (obstacle->check_dirty()) {
@@ -1301,24 +1653,160 @@ void NavMap::_update_rvo_obstacles_tree_2d() {
 	rvo_simulation_2d.kdTree_->buildObstacleTree(raw_obstacles);
 }
 
-void NavMap::_update_rvo_agents_tree_2d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO2D::Agent2D *> raw_agents;
-	raw_agents.reserve(active_2d_avoidance_agents.size());
+void NavMap::AvoidanceGrid::clear(uint32_t p_agent_count, real_t p_cell_size) {
+	cell_size = p_cell_size;
+	cells.clear();
+	agent_cells.resize(p_agent_count);
+	agent_cell_slots.resize(p_agent_count);
+	dirty = false;
+}
+
+void NavMap::AvoidanceGrid::update_agent(uint32_t p_index, const Vector3 &p_position, uint32_t p_avoidance_layers, bool p_insert) {
+	const Vector2i cell_key = Vector2i(Math::floor(p_position.x / cell_size), Math::floor(p_position.z / cell_size));
+
+	if (!p_insert) {
+		const Vector2i old_cell_key = agent_cells[p_index];
+		AvoidanceGridCell *old_cell = cells.getptr(old_cell_key);
+		const uint32_t slot = agent_cell_slots[p_index];
+
+		if (old_cell_key == cell_key) {
+			old_cell->positions_x[slot] = p_position.x;
+			old_cell->positions_y[slot] = p_position.y;
+			old_cell->positions_z[slot] = p_position.z;
+			old_cell->avoidance_layers[slot] = p_avoidance_layers;
+			return;
+		}
+
+		// The last agent of the cell is moved into the freed slot.
+		const uint32_t last_slot = old_cell->agents.size() - 1;
+		if (slot != last_slot) {
+			agent_cell_slots[old_cell->agents[last_slot]] = slot;
+		}
+		old_cell->agents.remove_at_unordered(slot);
+		old_cell->positions_x.remove_at_unordered(slot);
+		old_cell->positions_y.remove_at_unordered(slot);
+		old_cell->positions_z.remove_at_unordered(slot);
+		old_cell->avoidance_layers.remove_at_unordered(slot);
+		if (old_cell->agents.is_empty()) {
+			cells.erase(old_cell_key);
+		}
+	}
+
+	AvoidanceGridCell &cell = cells[cell_key];
+	agent_cells[p_index] = cell_key;
+	agent_cell_slots[p_index] = cell.agents.size();
+	cell.agents.push_back(p_index);
+	cell.positions_x.push_back(p_position.x);
+	cell.positions_y.push_back(p_position.y);
+	cell.positions_z.push_back(p_position.z);
+	cell.avoidance_layers.push_back(p_avoidance_layers);
+}
+
+real_t NavMap::_get_avoidance_grid_cell_size(LocalVector<real_t> &r_neighbor_distances) {
+	// Cells are sized from the median neighbor distance, so most queries only visit the cells next to the agent.
+	// A few agents with a large neighbor distance then visit more cells instead of making every query slower.
+	if (r_neighbor_distances.is_empty()) {
+		return 1.0;
+	}
+	r_neighbor_distances.sort();
+	return MAX(real_t(1.0), r_neighbor_distances[r_neighbor_distances.size() / 2]);
+}
+
+void NavMap::_update_avoidance_grid_2d() {
+	LocalVector<real_t> neighbor_distances;
+	neighbor_distances.reserve(active_2d_avoidance_agents.size());
 	for (NavAgent *agent : active_2d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_2d());
+		neighbor_distances.push_back(agent->get_rvo_agent_2d()->neighborDist_);
+	}
+	const real_t cell_size = _get_avoidance_grid_cell_size(neighbor_distances);
+
+	const bool rebuild = avoidance_grid_2d.dirty || avoidance_grid_2d.cell_size != cell_size;
+	if (rebuild) {
+		avoidance_grid_2d.clear(active_2d_avoidance_agents.size(), cell_size);
+	}
+
+	for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+		const RVO2D::Agent2D *rvo_agent = active_2d_avoidance_agents[i]->get_rvo_agent_2d();
+		avoidance_grid_2d.update_agent(i, Vector3(rvo_agent->position_.x(), 0.0, rvo_agent->position_.y()), rvo_agent->avoidance_layers_, rebuild);
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
 }
 
-void NavMap::_update_rvo_agents_tree_3d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO3D::Agent3D *> raw_agents;
-	raw_agents.reserve(active_3d_avoidance_agents.size());
+void NavMap::_update_avoidance_grid_3d() {
+	LocalVector<real_t> neighbor_distances;
+	neighbor_distances.reserve(active_3d_avoidance_agents.size());
 	for (NavAgent *agent : active_3d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_3d());
+		neighbor_distances.push_back(agent->get_rvo_agent_3d()->neighborDist_);
+	}
+	const real_t cell_size = _get_avoidance_grid_cell_size(neighbor_distances);
+
+	const bool rebuild = avoidance_grid_3d.dirty || avoidance_grid_3d.cell_size != cell_size;
+	if (rebuild) {
+		avoidance_grid_3d.clear(active_3d_avoidance_agents.size(), cell_size);
+	}
+
+	for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+		const RVO3D::Agent3D *rvo_agent = active_3d_avoidance_agents[i]->get_rvo_agent_3d();
+		avoidance_grid_3d.update_agent(i, Vector3(rvo_agent->position_.x(), rvo_agent->position_.y(), rvo_agent->position_.z()), rvo_agent->avoidance_layers_, rebuild);
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+}
+
+void NavMap::_compute_avoidance_neighbors_2d(RVO2D::Agent2D *p_agent) const {
+	p_agent->obstacleNeighbors_.clear();
+	float range_sq = RVO2D::sqr(p_agent->timeHorizonObst_ * p_agent->maxSpeed_ + p_agent->radius_);
+	rvo_simulation_2d.kdTree_->computeObstacleNeighbors(p_agent, range_sq);
+
+	p_agent->agentNeighbors_.clear();
+	if (p_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	range_sq = RVO2D::sqr(p_agent->neighborDist_);
+	const float position_x = p_agent->position_.x();
+	const float position_z = p_agent->position_.y();
+	const uint32_t avoidance_mask = p_agent->avoidance_mask_;
+
+	avoidance_grid_2d.for_each_cell_in_range(Vector3(position_x, 0.0, position_z), p_agent->neighborDist_, [&](const AvoidanceGridCell &p_cell) {
+		const uint32_t cell_agent_count = p_cell.agents.size();
+		const float *positions_x = p_cell.positions_x.ptr();
+		const float *positions_z = p_cell.positions_z.ptr();
+		const uint32_t *avoidance_layers = p_cell.avoidance_layers.ptr();
+		for (uint32_t i = 0; i < cell_agent_count; i++) {
+			const float dx = positions_x[i] - position_x;
+			const float dz = positions_z[i] - position_z;
+			if (dx * dx + dz * dz < range_sq && (avoidance_layers[i] & avoidance_mask)) {
+				p_agent->insertAgentNeighbor(active_2d_avoidance_agents[p_cell.agents[i]]->get_rvo_agent_2d(), range_sq);
+			}
+		}
+	});
+}
+
+void NavMap::_compute_avoidance_neighbors_3d(RVO3D::Agent3D *p_agent) const {
+	p_agent->agentNeighbors_.clear();
+	if (p_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	float range_sq = p_agent->neighborDist_ * p_agent->neighborDist_;
+	const float position_x = p_agent->position_.x();
+	const float position_y = p_agent->position_.y();
+	const float position_z = p_agent->position_.z();
+	const uint32_t avoidance_mask = p_agent->avoidance_mask_;
+
+	avoidance_grid_3d.for_each_cell_in_range(Vector3(position_x, position_y, position_z), p_agent->neighborDist_, [&](const AvoidanceGridCell &p_cell) {
+		const uint32_t cell_agent_count = p_cell.agents.size();
+		const float *positions_x = p_cell.positions_x.ptr();
+		const float *positions_y = p_cell.positions_y.ptr();
+		const float *positions_z = p_cell.positions_z.ptr();
+		const uint32_t *avoidance_layers = p_cell.avoidance_layers.ptr();
+		for (uint32_t i = 0; i < cell_agent_count; i++) {
+			const float dx = positions_x[i] - position_x;
+			const float dy = positions_y[i] - position_y;
+			const float dz = positions_z[i] - position_z;
+			if (dx * dx + dy * dy + dz * dz < range_sq && (avoidance_layers[i] & avoidance_mask)) {
+				p_agent->insertAgentNeighbor(active_3d_avoidance_agents[p_cell.agents[i]]->get_rvo_agent_3d(), range_sq);
+			}
+		}
+	});
 }
 
 void NavMap::_update_rvo_simulation() {
@@ -1326,20 +1814,20 @@ void NavMap::_update_rvo_simulation() {
 		_update_rvo_obstacles_tree_2d();
 	}
 	if (agents_dirty) {
-		_update_rvo_agents_tree_2d();
-		_update_rvo_agents_tree_3d();
+		_update_avoidance_grid_2d();
+		_update_avoidance_grid_3d();
 	}
 }
 
 void NavMap::compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+	_compute_avoidance_neighbors_2d((*(agent + index))->get_rvo_agent_2d());
 	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
 	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 	(*(agent + index))->update();
 }
 
 void NavMap::compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+	_compute_avoidance_neighbors_3d((*(agent + index))->get_rvo_agent_3d());
 	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
 	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 	(*(agent + index))->update();
@@ -1357,7 +1845,7 @@ void NavMap::step(real_t p_deltatime) {
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+				_compute_avoidance_neighbors_2d(agent->get_rvo_agent_2d());
 				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
 				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 				agent->update();
@@ -1371,7 +1859,7 @@ void NavMap::step(real_t p_deltatime) {
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+				_compute_avoidance_neighbors_3d(agent->get_rvo_agent_3d());
 				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
 				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 				agent->update();
@@ -1423,6 +1911,452 @@ void NavMap::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys
 	}
 }
 
+struct _PolygonBVHCompare {
+	const AABB *aabbs = nullptr;
+	int axis = 0;
+
+	_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+		// Compare centers, scaled by two.
+		const AABB &a = aabbs[p_a];
+		const AABB &b = aabbs[p_b];
+		return a.position[axis] * 2.0 + a.size[axis] < b.position[axis] * 2.0 + b.size[axis];
+	}
+};
+
+void NavMap::_update_polygon_bvh() {
+	polygon_bvh.clear();
+	polygon_bvh_indices.clear();
+
+	LocalVector<AABB> polygon_aabbs;
+	polygon_aabbs.resize(polygons.size());
+
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		const gd::Polygon &polygon = polygons[i];
+		if (polygon.points.size() < 3) {
+			// No faces, can't be the result of any query.
+			continue;
+		}
+
+		AABB aabb(polygon.points[0].pos, Vector3());
+		for (uint32_t j = 1; j < polygon.points.size(); j++) {
+			aabb.expand_to(polygon.points[j].pos);
+		}
+		// Margin so segments grazing flat polygons don't miss their bounds due to precision.
+		polygon_aabbs[i] = aabb.grow(CMP_EPSILON);
+		polygon_bvh_indices.push_back(i);
+	}
+
+	if (polygon_bvh_indices.is_empty()) {
+		return;
+	}
+
+	polygon_bvh.reserve(2 * (polygon_bvh_indices.size() / POLYGON_BVH_LEAF_SIZE + 1));
+	_build_polygon_bvh(polygon_aabbs, 0, polygon_bvh_indices.size());
+}
+
+void NavMap::_build_polygon_bvh(const LocalVector<AABB> &p_polygon_aabbs, uint32_t p_from, uint32_t p_to) {
+	const uint32_t node_index = polygon_bvh.size();
+	polygon_bvh.push_back(PolygonBVHNode());
+
+	AABB aabb = p_polygon_aabbs[polygon_bvh_indices[p_from]];
+	AABB centers(aabb.get_center(), Vector3());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		const AABB &polygon_aabb = p_polygon_aabbs[polygon_bvh_indices[i]];
+		aabb.merge_with(polygon_aabb);
+		centers.expand_to(polygon_aabb.get_center());
+	}
+	polygon_bvh[node_index].aabb = aabb;
+
+	if (p_to - p_from <= POLYGON_BVH_LEAF_SIZE) {
+		polygon_bvh[node_index].index = p_from;
+		polygon_bvh[node_index].count = p_to - p_from;
+		return;
+	}
+
+	// Median split along the axis where the polygon centers are the most spread out.
+	const uint32_t middle = (p_from + p_to) / 2;
+	SortArray<uint32_t, _PolygonBVHCompare> sorter;
+	sorter.compare.aabbs = p_polygon_aabbs.ptr();
+	sorter.compare.axis = centers.get_longest_axis_index();
+	sorter.nth_element(0, p_to - p_from, middle - p_from, polygon_bvh_indices.ptr() + p_from);
+
+	_build_polygon_bvh(p_polygon_aabbs, p_from, middle);
+	polygon_bvh[node_index].index = polygon_bvh.size();
+	_build_polygon_bvh(p_polygon_aabbs, middle, p_to);
+}
+
+int64_t NavMap::_get_closest_polygon(const Vector3 &p_point, bool p_use_layers, uint32_t p_navigation_layers, real_t p_max_distance_squared, Vector3 &r_closest_point, Face3 *r_closest_face) const {
+	int64_t closest_poly_index = -1;
+	real_t closest_point_ds = p_max_distance_squared;
+
+	if (polygon_bvh.is_empty()) {
+		return closest_poly_index;
+	}
+
+	struct StackEntry {
+		uint32_t node = 0;
+		real_t distance_squared = 0.0;
+	};
+
+	// The tree is balanced, so its depth can't exceed the bits of a polygon index.
+	StackEntry stack[64];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, 0.0 };
+
+	while (stack_size > 0) {
+		const StackEntry entry = stack[--stack_size];
+		// The maximum distance itself is still in range, until a polygon has been found.
+		if (closest_poly_index == -1 ? entry.distance_squared > closest_point_ds : entry.distance_squared >= closest_point_ds) {
+			continue;
+		}
+
+		const PolygonBVHNode &node = polygon_bvh[entry.node];
+		if (node.count == 0) {
+			// Visit the nearest child first, it's pushed last.
+			const uint32_t children[2] = { entry.node + 1, node.index };
+			real_t children_ds[2];
+			for (int i = 0; i < 2; i++) {
+				const AABB &child_aabb = polygon_bvh[children[i]].aabb;
+				children_ds[i] = p_point.clamp(child_aabb.position, child_aabb.get_end()).distance_squared_to(p_point);
+			}
+			const int nearest = children_ds[1] < children_ds[0] ? 1 : 0;
+			stack[stack_size++] = { children[1 - nearest], children_ds[1 - nearest] };
+			stack[stack_size++] = { children[nearest], children_ds[nearest] };
+			continue;
+		}
+
+		for (uint32_t i = node.index; i < node.index + node.count; i++) {
+			const uint32_t poly_index = polygon_bvh_indices[i];
+			const gd::Polygon &p = polygons[poly_index];
+			if (p_use_layers && (p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			// For each face check the distance to the point.
+			for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+				const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				const Vector3 point = face.get_closest_point_to(p_point);
+				const real_t ds = point.distance_squared_to(p_point);
+				if (ds < closest_point_ds || (closest_poly_index == -1 && ds == closest_point_ds)) {
+					closest_point_ds = ds;
+					closest_poly_index = poly_index;
+					r_closest_point = point;
+					if (r_closest_face) {
+						*r_closest_face = face;
+					}
+				}
+			}
+		}
+	}
+
+	return closest_poly_index;
+}
+
+void NavMap::_update_hierarchy(const HashSet<const NavBase *> &p_changed_owners) {
+	const uint32_t polygon_count = polygons.size() + link_polygons.size();
+
+	hierarchy_clusters.clear();
+	hierarchy_portals.clear();
+	hierarchy_polygon_clusters.resize(polygon_count);
+
+	// One cluster for each owner of polygons.
+	HashMap<const NavBase *, uint32_t> owner_clusters;
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const NavBase *owner = _get_polygon(polygon_id).owner;
+		HashMap<const NavBase *, uint32_t>::Iterator E = owner_clusters.find(owner);
+		uint32_t cluster_index;
+		if (E) {
+			cluster_index = E->value;
+		} else {
+			cluster_index = hierarchy_clusters.size();
+			owner_clusters.insert(owner, cluster_index);
+			hierarchy_clusters.push_back(HierarchyCluster());
+			hierarchy_clusters[cluster_index].owner = owner;
+		}
+		hierarchy_polygon_clusters[polygon_id] = cluster_index;
+		hierarchy_clusters[cluster_index].polygons.push_back(polygon_id);
+	}
+
+	// Group the connections going from one cluster to another into portals.
+	HashMap<uint64_t, uint32_t> cluster_pair_portals;
+	LocalVector<uint32_t> portal_connection_counts;
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const uint32_t from_cluster = hierarchy_polygon_clusters[polygon_id];
+		for (const gd::Edge &edge : _get_polygon(polygon_id).edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t to_cluster = hierarchy_polygon_clusters[connection.polygon->id];
+				if (to_cluster == from_cluster) {
+					continue;
+				}
+
+				const uint64_t cluster_pair = (uint64_t(from_cluster) << 32) | to_cluster;
+				HashMap<uint64_t, uint32_t>::Iterator E = cluster_pair_portals.find(cluster_pair);
+				uint32_t portal_index;
+				if (E) {
+					portal_index = E->value;
+				} else {
+					portal_index = hierarchy_portals.size();
+					cluster_pair_portals.insert(cluster_pair, portal_index);
+					portal_connection_counts.push_back(0);
+
+					HierarchyPortal new_portal;
+					new_portal.from_cluster = from_cluster;
+					new_portal.to_cluster = to_cluster;
+					new_portal.exit_index = hierarchy_clusters[from_cluster].exit_portals.size();
+					new_portal.entry_index = hierarchy_clusters[to_cluster].entry_portals.size();
+					hierarchy_portals.push_back(new_portal);
+
+					hierarchy_clusters[from_cluster].exit_portals.push_back(portal_index);
+					hierarchy_clusters[to_cluster].entry_portals.push_back(portal_index);
+				}
+
+				HierarchyPortal &portal = hierarchy_portals[portal_index];
+				portal.position += (connection.pathway_start + connection.pathway_end) * 0.5;
+				portal.exit_polygons.push_back(polygon_id);
+				portal.entry_polygons.push_back(connection.polygon->id);
+				portal_connection_counts[portal_index]++;
+			}
+		}
+	}
+
+	for (uint32_t portal_index = 0; portal_index < hierarchy_portals.size(); portal_index++) {
+		hierarchy_portals[portal_index].position /= portal_connection_counts[portal_index];
+	}
+
+	// Forget the costs of owners that are gone.
+	LocalVector<const NavBase *> removed_owners;
+	for (const KeyValue<const NavBase *, HierarchyClusterCosts> &E : hierarchy_cluster_costs) {
+		if (!owner_clusters.has(E.key)) {
+			removed_owners.push_back(E.key);
+		}
+	}
+	for (const NavBase *owner : removed_owners) {
+		hierarchy_cluster_costs.erase(owner);
+	}
+
+	LocalVector<Vector3> polygon_centers;
+	LocalVector<real_t> polygon_distances;
+
+	for (HierarchyCluster &cluster : hierarchy_clusters) {
+		HierarchyClusterCosts *costs = hierarchy_cluster_costs.getptr(cluster.owner);
+		if (costs == nullptr) {
+			costs = &hierarchy_cluster_costs.insert(cluster.owner, HierarchyClusterCosts())->value;
+		} else if (!p_changed_owners.has(cluster.owner) && costs->entry_positions.size() == cluster.entry_portals.size() && costs->exit_positions.size() == cluster.exit_portals.size()) {
+			// Reuse the costs when neither the polygons nor the portals of the cluster moved.
+			bool portals_changed = false;
+			for (uint32_t i = 0; i < cluster.entry_portals.size() && !portals_changed; i++) {
+				portals_changed = !costs->entry_positions[i].is_equal_approx(hierarchy_portals[cluster.entry_portals[i]].position);
+			}
+			for (uint32_t i = 0; i < cluster.exit_portals.size() && !portals_changed; i++) {
+				portals_changed = !costs->exit_positions[i].is_equal_approx(hierarchy_portals[cluster.exit_portals[i]].position);
+			}
+			if (!portals_changed) {
+				cluster.costs = costs;
+				continue;
+			}
+		}
+
+		if (polygon_centers.is_empty()) {
+			polygon_centers.resize(polygon_count);
+			polygon_distances.resize(polygon_count);
+			for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+				const gd::Polygon &polygon = _get_polygon(polygon_id);
+				Vector3 center;
+				for (const gd::Point &point : polygon.points) {
+					center += point.pos;
+				}
+				polygon_centers[polygon_id] = polygon.points.is_empty() ? center : center / polygon.points.size();
+			}
+		}
+
+		_update_hierarchy_cluster_costs(cluster, polygon_centers, polygon_distances, *costs);
+		cluster.costs = costs;
+	}
+}
+
+void NavMap::_update_hierarchy_cluster_costs(const HierarchyCluster &p_cluster, const LocalVector<Vector3> &p_polygon_centers, LocalVector<real_t> &r_polygon_distances, HierarchyClusterCosts &r_costs) const {
+	const uint32_t entry_count = p_cluster.entry_portals.size();
+	const uint32_t exit_count = p_cluster.exit_portals.size();
+	const uint32_t cluster_index = hierarchy_polygon_clusters[p_cluster.polygons[0]];
+
+	r_costs.entry_positions.resize(entry_count);
+	for (uint32_t i = 0; i < entry_count; i++) {
+		r_costs.entry_positions[i] = hierarchy_portals[p_cluster.entry_portals[i]].position;
+	}
+	r_costs.exit_positions.resize(exit_count);
+	for (uint32_t i = 0; i < exit_count; i++) {
+		r_costs.exit_positions[i] = hierarchy_portals[p_cluster.exit_portals[i]].position;
+	}
+	r_costs.distances.resize(entry_count * exit_count);
+
+	LocalVector<HierarchyHeapEntry> heap;
+	SortArray<HierarchyHeapEntry, HierarchyHeapCompare> heap_sort;
+
+	// Dijkstra from each entry portal over the centers of the cluster polygons.
+	for (uint32_t entry = 0; entry < entry_count; entry++) {
+		const HierarchyPortal &entry_portal = hierarchy_portals[p_cluster.entry_portals[entry]];
+
+		for (const uint32_t polygon_id : p_cluster.polygons) {
+			r_polygon_distances[polygon_id] = FLT_MAX;
+		}
+
+		heap.clear();
+		for (const uint32_t polygon_id : entry_portal.entry_polygons) {
+			const real_t distance = entry_portal.position.distance_to(p_polygon_centers[polygon_id]);
+			if (distance < r_polygon_distances[polygon_id]) {
+				r_polygon_distances[polygon_id] = distance;
+				heap.push_back({ distance, distance, polygon_id });
+				heap_sort.push_heap(0, heap.size() - 1, 0, heap[heap.size() - 1], heap.ptr());
+			}
+		}
+
+		while (!heap.is_empty()) {
+			heap_sort.pop_heap(0, heap.size(), heap.ptr());
+			const HierarchyHeapEntry current = heap[heap.size() - 1];
+			heap.resize(heap.size() - 1);
+			if (current.cost > r_polygon_distances[current.index]) {
+				continue;
+			}
+
+			for (const gd::Edge &edge : _get_polygon(current.index).edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					const uint32_t neighbor_id = connection.polygon->id;
+					if (hierarchy_polygon_clusters[neighbor_id] != cluster_index) {
+						continue;
+					}
+					const real_t distance = current.cost + p_polygon_centers[current.index].distance_to(p_polygon_centers[neighbor_id]);
+					if (distance < r_polygon_distances[neighbor_id]) {
+						r_polygon_distances[neighbor_id] = distance;
+						heap.push_back({ distance, distance, neighbor_id });
+						heap_sort.push_heap(0, heap.size() - 1, 0, heap[heap.size() - 1], heap.ptr());
+					}
+				}
+			}
+		}
+
+		for (uint32_t exit = 0; exit < exit_count; exit++) {
+			const HierarchyPortal &exit_portal = hierarchy_portals[p_cluster.exit_portals[exit]];
+			real_t best_distance = -1.0;
+			for (const uint32_t polygon_id : exit_portal.exit_polygons) {
+				if (r_polygon_distances[polygon_id] == FLT_MAX) {
+					continue;
+				}
+				const real_t distance = r_polygon_distances[polygon_id] + p_polygon_centers[polygon_id].distance_to(exit_portal.position);
+				if (best_distance < 0.0 || distance < best_distance) {
+					best_distance = distance;
+				}
+			}
+			r_costs.distances[entry * exit_count + exit] = best_distance;
+		}
+	}
+}
+
+bool NavMap::_find_hierarchy_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, PathQueryContext &r_context) const {
+	if (hierarchy_clusters.is_empty()) {
+		return false;
+	}
+
+	const uint32_t begin_cluster = hierarchy_polygon_clusters[p_begin_poly->id];
+	const uint32_t end_cluster = hierarchy_polygon_clusters[p_end_poly->id];
+
+	r_context.corridor_clusters.resize(hierarchy_clusters.size());
+	memset(r_context.corridor_clusters.ptr(), 0, r_context.corridor_clusters.size());
+	r_context.corridor_clusters[begin_cluster] = 1;
+
+	if (begin_cluster == end_cluster) {
+		return true;
+	}
+
+	LocalVector<real_t> &portal_costs = r_context.portal_costs;
+	LocalVector<int64_t> &portal_parents = r_context.portal_parents;
+	LocalVector<HierarchyHeapEntry> &heap = r_context.portal_heap;
+	SortArray<HierarchyHeapEntry, HierarchyHeapCompare> heap_sort;
+
+	portal_costs.resize(hierarchy_portals.size());
+	portal_parents.resize(hierarchy_portals.size());
+	for (uint32_t portal_index = 0; portal_index < hierarchy_portals.size(); portal_index++) {
+		portal_costs[portal_index] = FLT_MAX;
+		portal_parents[portal_index] = -1;
+	}
+	heap.clear();
+
+	// Portal costs are the cost to reach the portal, the same as the travel distances of the polygon search.
+	const real_t begin_travel_cost = hierarchy_clusters[begin_cluster].owner->get_travel_cost();
+	for (const uint32_t portal_index : hierarchy_clusters[begin_cluster].exit_portals) {
+		const HierarchyPortal &portal = hierarchy_portals[portal_index];
+		const NavBase *to_owner = hierarchy_clusters[portal.to_cluster].owner;
+		if ((p_navigation_layers & to_owner->get_navigation_layers()) == 0) {
+			continue;
+		}
+		const real_t cost = p_begin_point.distance_to(portal.position) * begin_travel_cost;
+		portal_costs[portal_index] = cost;
+		heap.push_back({ cost + portal.position.distance_to(p_end_point) * to_owner->get_travel_cost(), cost, portal_index });
+		heap_sort.push_heap(0, heap.size() - 1, 0, heap[heap.size() - 1], heap.ptr());
+	}
+
+	int64_t end_portal = -1;
+	real_t end_cost = FLT_MAX;
+
+	while (!heap.is_empty()) {
+		heap_sort.pop_heap(0, heap.size(), heap.ptr());
+		const HierarchyHeapEntry current = heap[heap.size() - 1];
+		heap.resize(heap.size() - 1);
+
+		if (current.priority >= end_cost) {
+			break;
+		}
+		if (current.cost > portal_costs[current.index]) {
+			continue;
+		}
+
+		const HierarchyPortal &portal = hierarchy_portals[current.index];
+		const HierarchyCluster &cluster = hierarchy_clusters[portal.to_cluster];
+		const real_t enter_cost = cluster.owner->get_enter_cost();
+		const real_t travel_cost = cluster.owner->get_travel_cost();
+
+		if (portal.to_cluster == end_cluster) {
+			const real_t cost = current.cost + enter_cost + portal.position.distance_to(p_end_point) * travel_cost;
+			if (cost < end_cost) {
+				end_cost = cost;
+				end_portal = current.index;
+			}
+			continue;
+		}
+
+		const uint32_t exit_count = cluster.exit_portals.size();
+		const real_t *distances = cluster.costs->distances.ptr() + portal.entry_index * exit_count;
+		for (uint32_t exit = 0; exit < exit_count; exit++) {
+			if (distances[exit] < 0.0) {
+				continue;
+			}
+
+			const uint32_t next_portal_index = cluster.exit_portals[exit];
+			const HierarchyPortal &next_portal = hierarchy_portals[next_portal_index];
+			const NavBase *next_owner = hierarchy_clusters[next_portal.to_cluster].owner;
+			if ((p_navigation_layers & next_owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			const real_t cost = current.cost + enter_cost + distances[exit] * travel_cost;
+			if (cost < portal_costs[next_portal_index]) {
+				portal_costs[next_portal_index] = cost;
+				portal_parents[next_portal_index] = current.index;
+				heap.push_back({ cost + next_portal.position.distance_to(p_end_point) * next_owner->get_travel_cost(), cost, next_portal_index });
+				heap_sort.push_heap(0, heap.size() - 1, 0, heap[heap.size() - 1], heap.ptr());
+			}
+		}
+	}
+
+	if (end_portal == -1) {
+		return false;
+	}
+
+	for (int64_t portal_index = end_portal; portal_index != -1; portal_index = portal_parents[portal_index]) {
+		r_context.corridor_clusters[hierarchy_portals[portal_index].to_cluster] = 1;
+	}
+	return true;
+}
+
 void NavMap::_update_merge_rasterizer_cell_dimensions() {
 	merge_rasterizer_cell_size = cell_size * merge_rasterizer_cell_scale;
 	merge_rasterizer_cell_height = cell_height * merge_rasterizer_cell_scale;
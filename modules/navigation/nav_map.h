@@ -36,6 +36,7 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_set.h"
 
 #include <KdTree2d.h>
 #include <KdTree3d.h>
@@ -84,6 +85,151 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Bounding volume hierarchy over the map polygons, used to find the polygons
+	/// near a query without visiting all of them. Rebuilt when the polygons change.
+	struct PolygonBVHNode {
+		AABB aabb;
+		/// Leaves reference `count` entries of `polygon_bvh_indices` starting at `index`.
+		/// Internal nodes have a `count` of 0, their left child follows them and `index` is their right child.
+		uint32_t index = 0;
+		uint32_t count = 0;
+	};
+	LocalVector<PolygonBVHNode> polygon_bvh;
+	LocalVector<uint32_t> polygon_bvh_indices;
+
+	static const uint32_t POLYGON_BVH_LEAF_SIZE = 4;
+
+	/// Extent of a free edge along the x axis, to find the free edges near each other.
+	struct FreeEdgeExtent {
+		real_t min_x = 0.0;
+		real_t max_x = 0.0;
+		int index = 0;
+
+		bool operator<(const FreeEdgeExtent &p_other) const {
+			return min_x < p_other.min_x;
+		}
+	};
+
+	/// Cluster graph used by hierarchical path queries. Each region and link is a cluster,
+	/// and the connections from one cluster to another are grouped into a portal.
+	/// Queries first search the portals, then only the polygons of the clusters on that route.
+	struct HierarchyPortal {
+		uint32_t from_cluster = 0;
+		uint32_t to_cluster = 0;
+		/// Index of the portal in the exits of `from_cluster` and in the entries of `to_cluster`.
+		uint32_t exit_index = 0;
+		uint32_t entry_index = 0;
+		/// Average of the connection pathways between the two clusters.
+		Vector3 position;
+		/// Ids of the polygons of `from_cluster` with connections to `to_cluster`, and of the polygons they lead to.
+		LocalVector<uint32_t> exit_polygons;
+		LocalVector<uint32_t> entry_polygons;
+	};
+
+	/// Distances to cross a cluster, kept between syncs and only recomputed when its polygons or portals change.
+	struct HierarchyClusterCosts {
+		LocalVector<Vector3> entry_positions;
+		LocalVector<Vector3> exit_positions;
+		/// Distance from each entry portal (rows) to each exit portal (columns), negative when there is no route.
+		/// Multiplied by the travel cost when queried so it stays valid when the cost changes.
+		LocalVector<real_t> distances;
+	};
+
+	struct HierarchyCluster {
+		const NavBase *owner = nullptr;
+		LocalVector<uint32_t> polygons;
+		LocalVector<uint32_t> entry_portals;
+		LocalVector<uint32_t> exit_portals;
+		const HierarchyClusterCosts *costs = nullptr;
+	};
+
+	struct HierarchyHeapEntry {
+		real_t priority = 0.0;
+		real_t cost = 0.0;
+		uint32_t index = 0;
+	};
+
+	struct HierarchyHeapCompare {
+		_FORCE_INLINE_ bool operator()(const HierarchyHeapEntry &p_a, const HierarchyHeapEntry &p_b) const {
+			return p_a.priority > p_b.priority;
+		}
+	};
+
+	LocalVector<HierarchyCluster> hierarchy_clusters;
+	LocalVector<HierarchyPortal> hierarchy_portals;
+	/// Cluster of each polygon, indexed by polygon id.
+	LocalVector<uint32_t> hierarchy_polygon_clusters;
+	HashMap<const NavBase *, HierarchyClusterCosts> hierarchy_cluster_costs;
+
+	/// Scratch data of a path query, kept per thread so queries don't allocate once it has grown enough.
+	struct PathQueryContext {
+		/// Reachable polygons found by the query.
+		LocalVector<gd::NavigationPoly> navigation_polys;
+		/// Indices in `navigation_polys` of the polygons left to visit.
+		LocalVector<uint32_t> to_visit;
+
+		/// Index in `navigation_polys` for each map polygon id, only valid when
+		/// the polygon's stamp matches the current one. This avoids clearing it for every query.
+		LocalVector<uint32_t> navigation_poly_indices;
+		LocalVector<uint32_t> navigation_poly_stamps;
+		uint32_t stamp = 0;
+
+		void begin(uint32_t p_polygon_count) {
+			if (navigation_poly_stamps.size() < p_polygon_count) {
+				const uint32_t previous_size = navigation_poly_stamps.size();
+				navigation_poly_indices.resize(p_polygon_count);
+				navigation_poly_stamps.resize(p_polygon_count);
+				memset(navigation_poly_stamps.ptr() + previous_size, 0, sizeof(uint32_t) * (p_polygon_count - previous_size));
+			}
+
+			stamp++;
+			if (unlikely(stamp == 0)) {
+				// Wrapped around, stale stamps could match again.
+				memset(navigation_poly_stamps.ptr(), 0, sizeof(uint32_t) * navigation_poly_stamps.size());
+				stamp = 1;
+			}
+
+			navigation_polys.clear();
+			to_visit.clear();
+		}
+
+		void add_navigation_poly(const gd::NavigationPoly &p_navigation_poly) {
+			navigation_poly_indices[p_navigation_poly.poly->id] = navigation_polys.size();
+			navigation_poly_stamps[p_navigation_poly.poly->id] = stamp;
+			navigation_polys.push_back(p_navigation_poly);
+		}
+
+		int64_t find_navigation_poly(const gd::Polygon *p_polygon) const {
+			return navigation_poly_stamps[p_polygon->id] == stamp ? navigation_poly_indices[p_polygon->id] : -1;
+		}
+
+		/// Clusters the search is restricted to in hierarchical queries, and the scratch data of the portal search.
+		LocalVector<uint8_t> corridor_clusters;
+		LocalVector<real_t> portal_costs;
+		LocalVector<int64_t> portal_parents;
+		LocalVector<HierarchyHeapEntry> portal_heap;
+	};
+	static thread_local PathQueryContext path_query_context;
+
+	/// Integration field over the map polygons towards the polygons of one or more targets, shared by all agents moving to them.
+	/// It only depends on the target polygons, so targets moving inside their polygons keep using it.
+	struct FlowField {
+		LocalVector<uint32_t> target_polygons;
+		uint32_t navigation_layers = 0;
+		/// Travel cost from each polygon to the closest target polygon, FLT_MAX when none can be reached.
+		LocalVector<real_t> distances;
+		/// Polygon each polygon is left for towards the targets, and the gateway leading to it.
+		LocalVector<int64_t> next_polygons;
+		LocalVector<Vector3> pathway_starts;
+		LocalVector<Vector3> pathway_ends;
+	};
+	/// Flow fields computed since the polygons or the layers and costs of their owners last changed, the oldest one is replaced when all slots are used.
+	mutable RWLock flow_field_rwlock;
+	mutable LocalVector<FlowField> flow_fields;
+	mutable uint32_t flow_field_next_index = 0;
+
+	static const uint32_t MAX_FLOW_FIELDS = 16;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -92,6 +238,55 @@ class NavMap : public NavRid {
 	LocalVector<NavAgent *> active_2d_avoidance_agents;
 	LocalVector<NavAgent *> active_3d_avoidance_agents;
 
+	/// Agents of a grid cell, with their positions and layers in separate arrays so neighbor queries scan them without touching the agents.
+	struct AvoidanceGridCell {
+		LocalVector<uint32_t> agents;
+		LocalVector<float> positions_x;
+		LocalVector<float> positions_y;
+		LocalVector<float> positions_z;
+		LocalVector<uint32_t> avoidance_layers;
+	};
+
+	/// Uniform grid of the avoidance agents on the xz plane, used for the agent neighbor queries instead of the RVO agent KD-trees.
+	/// Agents only change cells when crossing a cell border, so the grid is updated in place on sync instead of being rebuilt.
+	struct AvoidanceGrid {
+		real_t cell_size = 1.0;
+		HashMap<Vector2i, AvoidanceGridCell> cells;
+		/// Cell and index inside the cell of each active avoidance agent.
+		LocalVector<Vector2i> agent_cells;
+		LocalVector<uint32_t> agent_cell_slots;
+		/// Set when the active avoidance agents changed, as the grid is indexed by their order.
+		bool dirty = true;
+
+		void clear(uint32_t p_agent_count, real_t p_cell_size);
+		void update_agent(uint32_t p_index, const Vector3 &p_position, uint32_t p_avoidance_layers, bool p_insert);
+
+		/// Calls p_func on each occupied cell within p_range of the cell containing p_position.
+		/// Agents whose range covers more cells than are occupied visit the occupied cells directly.
+		template <typename F>
+		void for_each_cell_in_range(const Vector3 &p_position, real_t p_range, F p_func) const {
+			const int64_t cell_range = Math::ceil(p_range / cell_size);
+			if ((2 * cell_range + 1) * (2 * cell_range + 1) > (int64_t)cells.size()) {
+				for (const KeyValue<Vector2i, AvoidanceGridCell> &E : cells) {
+					p_func(E.value);
+				}
+				return;
+			}
+
+			const Vector2i center = Vector2i(Math::floor(p_position.x / cell_size), Math::floor(p_position.z / cell_size));
+			for (int z = center.y - cell_range; z <= center.y + cell_range; z++) {
+				for (int x = center.x - cell_range; x <= center.x + cell_range; x++) {
+					const AvoidanceGridCell *cell = cells.getptr(Vector2i(x, z));
+					if (cell != nullptr) {
+						p_func(*cell);
+					}
+				}
+			}
+		}
+	};
+	AvoidanceGrid avoidance_grid_2d;
+	AvoidanceGrid avoidance_grid_3d;
+
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
@@ -166,7 +361,7 @@ public:
 
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
-	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
+	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, bool p_use_hierarchy = false) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -203,6 +398,7 @@ public:
 	}
 
 	Vector3 get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const;
+	Vector3 get_flow_direction(const Vector<Vector3> &p_targets, const Vector3 &p_position, uint32_t p_navigation_layers) const;
 
 	void sync();
 	void step(real_t p_deltatime);
@@ -228,10 +424,27 @@ private:
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
-	void _update_rvo_agents_tree_2d();
-	void _update_rvo_agents_tree_3d();
+	static real_t _get_avoidance_grid_cell_size(LocalVector<real_t> &r_neighbor_distances);
+	void _update_avoidance_grid_2d();
+	void _update_avoidance_grid_3d();
+	void _compute_avoidance_neighbors_2d(RVO2D::Agent2D *p_agent) const;
+	void _compute_avoidance_neighbors_3d(RVO3D::Agent3D *p_agent) const;
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	void _update_polygon_bvh();
+	void _build_polygon_bvh(const LocalVector<AABB> &p_polygon_aabbs, uint32_t p_from, uint32_t p_to);
+	int64_t _get_closest_polygon(const Vector3 &p_point, bool p_use_layers, uint32_t p_navigation_layers, real_t p_max_distance_squared, Vector3 &r_closest_point, Face3 *r_closest_face = nullptr) const;
+
+	const gd::Polygon &_get_polygon(uint32_t p_id) const {
+		return p_id < polygons.size() ? polygons[p_id] : link_polygons[p_id - polygons.size()];
+	}
+	void _update_hierarchy(const HashSet<const NavBase *> &p_changed_owners);
+	void _update_hierarchy_cluster_costs(const HierarchyCluster &p_cluster, const LocalVector<Vector3> &p_polygon_centers, LocalVector<real_t> &r_polygon_distances, HierarchyClusterCosts &r_costs) const;
+	int64_t _find_flow_field(const LocalVector<uint32_t> &p_target_polygons, uint32_t p_navigation_layers) const;
+	void _compute_flow_field(FlowField &r_flow_field) const;
+	Vector3 _get_flow_field_direction(const FlowField &p_flow_field, uint32_t p_polygon_id, const Vector3 &p_point) const;
+	bool _find_hierarchy_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, PathQueryContext &r_context) const;
 };
 
 #endif // NAV_MAP_H
@@ -136,29 +136,34 @@ Vector3 NavRegion::get_random_point(uint32_t p_navigation_layers, bool p_uniform
 	}
 
 	if (p_uniformly) {
-		real_t accumulated_area = 0;
-		RBMap<real_t, uint32_t> region_area_map;
-
-		for (uint32_t rp_index = 0; rp_index < region_polygons.size(); rp_index++) {
-			const gd::Polygon &region_polygon = region_polygons[rp_index];
-			real_t polyon_area = region_polygon.surface_area;
-
-			if (polyon_area == 0.0) {
-				continue;
-			}
-			region_area_map[accumulated_area] = rp_index;
-			accumulated_area += polyon_area;
-		}
-		if (region_area_map.is_empty() || accumulated_area == 0) {
+		ERR_FAIL_COND_V(accumulated_polygon_areas.size() != region_polygons.size(), Vector3());
+		const real_t accumulated_area = accumulated_polygon_areas[accumulated_polygon_areas.size() - 1];
+		if (accumulated_area == 0) {
 			// All polygons have no real surface / no area.
 			return Vector3();
 		}
 
 		real_t region_area_map_pos = Math::random(real_t(0), accumulated_area);
 
-		RBMap<real_t, uint32_t>::Iterator region_E = region_area_map.find_closest(region_area_map_pos);
-		ERR_FAIL_COND_V(!region_E, Vector3());
-		uint32_t rrp_polygon_index = region_E->value;
+		// Find the first polygon whose accumulated area goes past the random position,
+		// polygons without area can't be picked this way.
+		uint32_t rrp_polygon_index = 0;
+		uint32_t search_end = accumulated_polygon_areas.size();
+		while (rrp_polygon_index < search_end) {
+			const uint32_t middle = (rrp_polygon_index + search_end) / 2;
+			if (accumulated_polygon_areas[middle] <= region_area_map_pos) {
+				rrp_polygon_index = middle + 1;
+			} else {
+				search_end = middle;
+			}
+		}
+		if (rrp_polygon_index == accumulated_polygon_areas.size()) {
+			// The random position is the total area, take the last polygon with an area.
+			rrp_polygon_index--;
+			while (region_polygons[rrp_polygon_index].surface_area == 0.0) {
+				rrp_polygon_index--;
+			}
+		}
 		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector3());
 
 		const gd::Polygon &rr_polygon = region_polygons[rrp_polygon_index];
@@ -220,6 +225,9 @@ void NavRegion::update_polygons() {
 	}
 	polygons.clear();
 	surface_area = 0.0;
+	accumulated_polygon_areas.clear();
+	edge_merges.clear();
+	border_edges.clear();
 	polygons_dirty = false;
 
 	if (map == nullptr) {
@@ -295,4 +303,42 @@ void NavRegion::update_polygons() {
 	}
 
 	surface_area = _new_region_surface_area;
+
+	accumulated_polygon_areas.resize(polygons.size());
+	real_t accumulated_area = 0.0;
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		accumulated_area += polygons[i].surface_area;
+		accumulated_polygon_areas[i] = accumulated_area;
+	}
+
+	// Merge the edges shared by polygons of this region, the others are left for the map to connect.
+	// Edges are indexed by key until merged, then mapped to -1.
+	HashMap<gd::EdgeKey, int64_t, gd::EdgeKey> unmerged_edges;
+	LocalVector<BorderEdge> edges;
+	for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+		const gd::Polygon &polygon = polygons[polygon_index];
+		for (uint32_t p = 0; p < polygon.points.size(); p++) {
+			const gd::EdgeKey ek(polygon.points[p].key, polygon.points[(p + 1) % polygon.points.size()].key);
+
+			HashMap<gd::EdgeKey, int64_t, gd::EdgeKey>::Iterator E = unmerged_edges.find(ek);
+			if (!E) {
+				unmerged_edges.insert(ek, edges.size());
+				edges.push_back({ polygon_index, p });
+			} else if (E->value != -1) {
+				BorderEdge &other_edge = edges[E->value];
+				edge_merges.push_back({ other_edge.polygon, other_edge.edge, polygon_index, p });
+				other_edge.polygon = UINT32_MAX;
+				E->value = -1;
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+			}
+		}
+	}
+
+	for (const BorderEdge &edge : edges) {
+		if (edge.polygon != UINT32_MAX) {
+			border_edges.push_back(edge);
+		}
+	}
 }
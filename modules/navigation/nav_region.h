@@ -38,6 +38,22 @@
 #include "scene/resources/navigation_mesh.h"
 
 class NavRegion : public NavBase {
+public:
+	/// Two polygon edges of this region sharing the same points.
+	struct EdgeMerge {
+		uint32_t polygon_a = 0;
+		uint32_t edge_a = 0;
+		uint32_t polygon_b = 0;
+		uint32_t edge_b = 0;
+	};
+
+	/// A polygon edge not shared with another polygon of this region.
+	struct BorderEdge {
+		uint32_t polygon = 0;
+		uint32_t edge = 0;
+	};
+
+private:
 	NavMap *map = nullptr;
 	Transform3D transform;
 	Vector<gd::Edge::Connection> connections;
@@ -52,6 +68,14 @@ class NavRegion : public NavBase {
 
 	real_t surface_area = 0.0;
 
+	/// Surface area of all polygons up to and including each one, to pick random polygons by area.
+	LocalVector<real_t> accumulated_polygon_areas;
+
+	/// Edges merged inside this region, found when the polygons change so the
+	/// map only has to merge the border edges of its regions when it syncs.
+	LocalVector<EdgeMerge> edge_merges;
+	LocalVector<BorderEdge> border_edges;
+
 	RWLock navmesh_rwlock;
 	Vector<Vector3> pending_navmesh_vertices;
 	Vector<Vector<int>> pending_navmesh_polygons;
@@ -96,6 +120,14 @@ public:
 		return polygons;
 	}
 
+	const LocalVector<EdgeMerge> &get_edge_merges() const {
+		return edge_merges;
+	}
+
+	const LocalVector<BorderEdge> &get_border_edges() const {
+		return border_edges;
+	}
+
 	Vector3 get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const;
 
 	real_t get_surface_area() const { return surface_area; };
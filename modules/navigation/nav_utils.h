@@ -107,6 +107,9 @@ struct Polygon {
 	/// The edges of this `Polygon`
 	LocalVector<Edge> edges;
 
+	/// Index of this polygon in its map, link polygons come after all region polygons.
+	uint32_t id = 0;
+
 	real_t surface_area = 0.0;
 };
 
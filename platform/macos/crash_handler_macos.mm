@@ -171,6 +171,7 @@ static void handle_crash(int sig) {
 	}
 	print_error("-- END OF BACKTRACE --");
 	print_error("================================================================");
+	OS::get_singleton()->flush_loggers();
 
 	// Abort to pass the error to the OS
 	abort();
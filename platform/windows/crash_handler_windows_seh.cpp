@@ -222,6 +222,7 @@ DWORD CrashHandlerException(EXCEPTION_POINTERS *ep) {
 
 	print_error("-- END OF BACKTRACE --");
 	print_error("================================================================");
+	OS::get_singleton()->flush_loggers();
 
 	SymCleanup(process);
 
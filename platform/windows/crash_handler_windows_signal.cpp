@@ -172,6 +172,7 @@ extern void CrashHandlerException(int signal) {
 
 	print_error("-- END OF BACKTRACE --");
 	print_error("================================================================");
+	OS::get_singleton()->flush_loggers();
 }
 #endif
 
@@ -106,6 +106,9 @@ public:
 
 	virtual Vector2 map_get_random_point(RID p_map, uint32_t p_navigation_layers, bool p_uniformly) const = 0;
 
+	/// Returns the direction to move in from the position to reach the closest target, sampled from a flow field shared by all queries to the same targets.
+	virtual Vector2 map_get_flow_direction(RID p_map, const Vector<Vector2> &p_targets, const Vector2 &p_position, uint32_t p_navigation_layers = 1) const = 0;
+
 	/// Creates a new region.
 	virtual RID region_create() = 0;
 
@@ -304,6 +307,7 @@ public:
 	virtual void parse_source_geometry_data(const Ref<NavigationPolygon> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData2D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationPolygon> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData2D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationPolygon> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData2D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
+	virtual Dictionary bake_tiles_from_source_geometry_data(const Ref<NavigationPolygon> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData2D> &p_source_geometry_data, real_t p_tile_size) = 0;
 	virtual bool is_baking_navigation_polygon(Ref<NavigationPolygon> p_navigation_polygon) const = 0;
 
 	virtual RID source_geometry_parser_create() = 0;
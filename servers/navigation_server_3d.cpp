@@ -31,6 +31,7 @@
 #include "navigation_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/main/node.h"
 
 NavigationServer3D *NavigationServer3D::singleton = nullptr;
@@ -70,8 +71,10 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_iteration_id", "map"), &NavigationServer3D::map_get_iteration_id);
 
 	ClassDB::bind_method(D_METHOD("map_get_random_point", "map", "navigation_layers", "uniformly"), &NavigationServer3D::map_get_random_point);
+	ClassDB::bind_method(D_METHOD("map_get_flow_direction", "map", "targets", "position", "navigation_layers"), &NavigationServer3D::map_get_flow_direction, DEFVAL(1));
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer3D::query_path);
+	ClassDB::bind_method(D_METHOD("query_paths", "parameters", "callback"), &NavigationServer3D::query_paths);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_enabled", "region", "enabled"), &NavigationServer3D::region_set_enabled);
@@ -185,6 +188,7 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("parse_source_geometry_data", "navigation_mesh", "source_geometry_data", "root_node", "callback"), &NavigationServer3D::parse_source_geometry_data, DEFVAL(Callable()));
 	ClassDB::bind_method(D_METHOD("bake_from_source_geometry_data", "navigation_mesh", "source_geometry_data", "callback"), &NavigationServer3D::bake_from_source_geometry_data, DEFVAL(Callable()));
 	ClassDB::bind_method(D_METHOD("bake_from_source_geometry_data_async", "navigation_mesh", "source_geometry_data", "callback"), &NavigationServer3D::bake_from_source_geometry_data_async, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("bake_tiles_from_source_geometry_data", "navigation_mesh", "source_geometry_data", "tile_size"), &NavigationServer3D::bake_tiles_from_source_geometry_data);
 	ClassDB::bind_method(D_METHOD("is_baking_navigation_mesh", "navigation_mesh"), &NavigationServer3D::is_baking_navigation_mesh);
 #endif // _3D_DISABLED
 
@@ -943,6 +947,55 @@ void NavigationServer3D::query_path(const Ref<NavigationPathQueryParameters3D> &
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+struct _NavigationPathQueryBatch3D {
+	const NavigationServer3D *server = nullptr;
+	LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+	LocalVector<NavigationUtilities::PathQueryResult> results;
+
+	static void process(void *p_userdata, uint32_t p_index) {
+		_NavigationPathQueryBatch3D *batch = static_cast<_NavigationPathQueryBatch3D *>(p_userdata);
+		batch->results[p_index] = batch->server->_query_path(batch->parameters[p_index]);
+	}
+};
+
+void NavigationServer3D::query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const Callable &p_callback) const {
+	_NavigationPathQueryBatch3D batch;
+	batch.server = this;
+	batch.parameters.resize(p_query_parameters.size());
+	batch.results.resize(p_query_parameters.size());
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		ERR_FAIL_COND_MSG(query_parameters.is_null(), vformat("Invalid path query parameters at index %d.", i));
+		batch.parameters[i] = query_parameters->get_parameters();
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (batch.parameters.size() > 1 && pool->get_thread_count() > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_id = pool->add_native_group_task(&_NavigationPathQueryBatch3D::process, &batch, batch.parameters.size(), -1, true, SNAME("NavigationServer3DQueryPaths"));
+		pool->wait_for_group_task_completion(group_id);
+	} else {
+		for (uint32_t i = 0; i < batch.parameters.size(); i++) {
+			_NavigationPathQueryBatch3D::process(&batch, i);
+		}
+	}
+
+	TypedArray<NavigationPathQueryResult3D> query_results;
+	query_results.resize(batch.results.size());
+	for (uint32_t i = 0; i < batch.results.size(); i++) {
+		Ref<NavigationPathQueryResult3D> query_result;
+		query_result.instantiate();
+		query_result->set_path(batch.results[i].path);
+		query_result->set_path_types(batch.results[i].path_types);
+		query_result->set_path_rids(batch.results[i].path_rids);
+		query_result->set_path_owner_ids(batch.results[i].path_owner_ids);
+		query_results[i] = query_result;
+	}
+
+	if (p_callback.is_valid()) {
+		p_callback.call(query_results);
+	}
+}
+
 ///////////////////////////////////////////////////////
 
 NavigationServer3DCallback NavigationServer3DManager::create_callback = nullptr;
@@ -50,6 +50,7 @@ public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
+	virtual bool is_pre_solve_thread_safe() const override { return false; } // Areas are shared between islands.
 
 	GodotAreaPair3D(GodotBody3D *p_body, int p_body_shape, GodotArea3D *p_area, int p_area_shape);
 	~GodotAreaPair3D();
@@ -71,6 +72,7 @@ public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
+	virtual bool is_pre_solve_thread_safe() const override { return false; } // Areas are shared between islands.
 
 	GodotArea2Pair3D(GodotArea3D *p_area_a, int p_shape_a, GodotArea3D *p_area_b, int p_shape_b);
 	~GodotArea2Pair3D();
@@ -90,6 +92,7 @@ public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
+	virtual bool is_pre_solve_thread_safe() const override { return false; } // Areas are shared between islands.
 
 	GodotAreaSoftBodyPair3D(GodotSoftBody3D *p_sof_body, int p_soft_body_shape, GodotArea3D *p_area, int p_area_shape);
 	~GodotAreaSoftBodyPair3D();
@@ -299,6 +299,10 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 	PhysicsServer3D::BodyMode prev = mode;
 	mode = p_mode;
 
+	if (get_space() && (prev > PhysicsServer3D::BODY_MODE_KINEMATIC) != (mode > PhysicsServer3D::BODY_MODE_KINEMATIC)) {
+		get_space()->add_rigid_body_count(mode > PhysicsServer3D::BODY_MODE_KINEMATIC ? 1 : -1);
+	}
+
 	switch (p_mode) {
 		case PhysicsServer3D::BODY_MODE_STATIC:
 		case PhysicsServer3D::BODY_MODE_KINEMATIC: {
@@ -448,6 +452,9 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 		if (direct_state_query_list.in_list()) {
 			get_space()->body_remove_from_state_query_list(&direct_state_query_list);
 		}
+		if (mode > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			get_space()->add_rigid_body_count(-1);
+		}
 	}
 
 	_set_space(p_space);
@@ -455,6 +462,10 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
 		_mass_properties_changed();
 
+		if (mode > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			get_space()->add_rigid_body_count(1);
+		}
+
 		if (active && !active_list.in_list()) {
 			get_space()->body_add_to_active_list(&active_list);
 		}
@@ -798,6 +809,48 @@ bool GodotBody3D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody3D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.constant_linear_velocity = constant_linear_velocity;
+	r_state.constant_angular_velocity = constant_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_force = constant_force;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody3D::set_snapshot_state(const SnapshotState &p_state) {
+	if (get_transform() != p_state.transform) {
+		_set_transform(p_state.transform);
+		_set_inv_transform(p_state.transform.affine_inverse());
+		if (mode > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			_update_transform_dependent();
+		}
+	}
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	constant_linear_velocity = p_state.constant_linear_velocity;
+	constant_angular_velocity = p_state.constant_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	biased_linear_velocity = Vector3();
+	biased_angular_velocity = Vector3();
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+}
+
 void GodotBody3D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
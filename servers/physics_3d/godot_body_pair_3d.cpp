@@ -38,6 +38,25 @@
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math_PI / 8)
 
+// Resting pairs keep their contacts without running the narrow phase, for a limited amount of steps.
+#define CONTACT_REUSE_MAX_STEPS 4
+// Maximum motion allowed for reusing contacts, relative to the contact recycle radius.
+#define CONTACT_REUSE_DISTANCE_RATIO 0.1
+#define CONTACT_REUSE_MAX_BASIS_DELTA 0.0005
+
+static _FORCE_INLINE_ bool _is_xform_resting(const Transform3D &p_xform, const Transform3D &p_last_xform, real_t p_max_distance) {
+	if (p_xform.origin.distance_squared_to(p_last_xform.origin) > p_max_distance * p_max_distance) {
+		return false;
+	}
+	for (int i = 0; i < 3; i++) {
+		const Vector3 delta = (p_xform.basis.rows[i] - p_last_xform.basis.rows[i]).abs();
+		if (delta.x > CONTACT_REUSE_MAX_BASIS_DELTA || delta.y > CONTACT_REUSE_MAX_BASIS_DELTA || delta.z > CONTACT_REUSE_MAX_BASIS_DELTA) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(p_userdata);
 	pair->contact_added_callback(p_point_A, p_index_A, p_point_B, p_index_B, normal);
@@ -60,21 +79,38 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
+	// Pick the closest previous contact on the same features, skipping the ones already matched
+	// during this step, so jittering points don't steal each other's accumulated impulses.
 	real_t contact_recycle_radius = space->get_contact_recycle_radius();
+	real_t contact_recycle_radius2 = contact_recycle_radius * contact_recycle_radius;
 
+	int recycled = -1;
+	real_t recycled_distance2 = 0.0;
 	for (int i = 0; i < contact_count; i++) {
-		Contact &c = contacts[i];
-		if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
-				c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
-			c = contact;
-			return;
+		const Contact &c = contacts[i];
+		if (c.used || c.index_A != p_index_A || c.index_B != p_index_B) {
+			continue;
+		}
+		real_t distance_A2 = c.local_A.distance_squared_to(local_A);
+		real_t distance_B2 = c.local_B.distance_squared_to(local_B);
+		if (distance_A2 < contact_recycle_radius2 && distance_B2 < contact_recycle_radius2) {
+			if (recycled == -1 || distance_A2 + distance_B2 < recycled_distance2) {
+				recycled = i;
+				recycled_distance2 = distance_A2 + distance_B2;
+			}
 		}
 	}
 
+	if (recycled != -1) {
+		Contact &c = contacts[recycled];
+		contact.acc_normal_impulse = c.acc_normal_impulse;
+		contact.acc_bias_impulse = c.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		contact.acc_tangent_impulse = c.acc_tangent_impulse;
+		c = contact;
+		return;
+	}
+
 	// Figure out if the contact amount must be reduced to fit the new contact.
 	if (new_index == MAX_CONTACTS) {
 		// Remove the contact with the minimum depth.
@@ -294,6 +330,22 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
+	real_t max_resting_distance = space->get_contact_recycle_radius() * CONTACT_REUSE_DISTANCE_RATIO;
+	if (collided && contact_count > 0 && reused_contact_steps < CONTACT_REUSE_MAX_STEPS &&
+			_is_xform_resting(xform_A, last_xform_A, max_resting_distance) && _is_xform_resting(xform_B, last_xform_B, max_resting_distance)) {
+		// Shapes barely moved relative to each other since the last narrow phase,
+		// keep solving with the same contacts and their accumulated impulses.
+		reused_contact_steps++;
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].used = true;
+		}
+		return true;
+	}
+
+	reused_contact_steps = 0;
+	last_xform_A = xform_A;
+	last_xform_B = xform_B;
+
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
 	if (!collided) {
@@ -451,6 +503,17 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	return do_process;
 }
 
+bool GodotBodyPair3D::is_pre_solve_thread_safe() const {
+	// Static bodies don't connect islands, so adding contacts to them could happen from several islands at once.
+	if (A->get_mode() == PhysicsServer3D::BODY_MODE_STATIC && A->can_report_contacts()) {
+		return false;
+	}
+	if (B->get_mode() == PhysicsServer3D::BODY_MODE_STATIC && B->can_report_contacts()) {
+		return false;
+	}
+	return true;
+}
+
 void GodotBodyPair3D::solve(real_t p_step) {
 	if (!collided) {
 		return;
@@ -595,6 +658,43 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::save_snapshot(uint8_t *r_data) const {
+	SnapshotState state;
+	state.body_B = B->get_self().get_id();
+	state.shape_A = shape_A;
+	state.shape_B = shape_B;
+	for (int i = 0; i < contact_count; i++) {
+		state.contacts[i] = contacts[i];
+	}
+	state.contact_count = contact_count;
+	state.sep_axis = sep_axis;
+	state.collided = collided;
+	state.last_xform_A = last_xform_A;
+	state.last_xform_B = last_xform_B;
+	state.reused_contact_steps = reused_contact_steps;
+	memcpy(r_data, &state, sizeof(SnapshotState));
+}
+
+bool GodotBodyPair3D::load_snapshot(const uint8_t *p_data) {
+	SnapshotState state;
+	memcpy(&state, p_data, sizeof(SnapshotState));
+	if (state.body_B != B->get_self().get_id() || state.shape_A != shape_A || state.shape_B != shape_B) {
+		return false;
+	}
+	ERR_FAIL_INDEX_V(state.contact_count, MAX_CONTACTS + 1, false);
+
+	for (int i = 0; i < state.contact_count; i++) {
+		contacts[i] = state.contacts[i];
+	}
+	contact_count = state.contact_count;
+	sep_axis = state.sep_axis;
+	collided = state.collided;
+	last_xform_A = state.last_xform_A;
+	last_xform_B = state.last_xform_B;
+	reused_contact_steps = state.reused_contact_steps;
+	return true;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
@@ -833,6 +933,10 @@ bool GodotBodySoftBodyPair3D::pre_solve(real_t p_step) {
 	return do_process;
 }
 
+bool GodotBodySoftBodyPair3D::is_pre_solve_thread_safe() const {
+	return !(body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC && body->can_report_contacts());
+}
+
 void GodotBodySoftBodyPair3D::solve(real_t p_step) {
 	if (!collided) {
 		return;
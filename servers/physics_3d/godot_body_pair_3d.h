@@ -97,6 +97,26 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Shape transforms used by the last narrow phase, to detect resting pairs.
+	Transform3D last_xform_A;
+	Transform3D last_xform_B;
+	int reused_contact_steps = 0;
+
+	struct SnapshotState {
+		// Identifies the pair, body A is stored by the space.
+		uint64_t body_B = 0;
+		int shape_A = 0;
+		int shape_B = 0;
+
+		Contact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		Vector3 sep_axis;
+		bool collided = false;
+		Transform3D last_xform_A;
+		Transform3D last_xform_B;
+		int reused_contact_steps = 0;
+	};
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
@@ -108,6 +128,11 @@ public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
+	virtual bool is_pre_solve_thread_safe() const override;
+
+	virtual uint32_t get_snapshot_size() const override { return sizeof(SnapshotState); }
+	virtual void save_snapshot(uint8_t *r_data) const override;
+	virtual bool load_snapshot(const uint8_t *p_data) override;
 
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
@@ -136,6 +161,7 @@ public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
+	virtual bool is_pre_solve_thread_safe() const override;
 
 	virtual GodotSoftBody3D *get_soft_body_ptr(int p_index) const override { return soft_body; }
 	virtual int get_soft_body_count() const override { return 1; }
@@ -645,8 +645,9 @@ public:
 
 		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
 
-		shape_A->project_range(axis, *transform_A, min_A, max_A);
-		shape_B->project_range(axis, *transform_B, min_B, max_B);
+		// Shape types are known here, so skip the virtual dispatch in this hot path.
+		shape_A->ShapeA::project_range(axis, *transform_A, min_A, max_A);
+		shape_B->ShapeB::project_range(axis, *transform_B, min_B, max_B);
 
 		if (withMargin) {
 			min_A -= margin_A;
@@ -1079,10 +1080,13 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
+	const Vector3 columns_a[3] = { p_transform_a.basis.get_column(0), p_transform_a.basis.get_column(1), p_transform_a.basis.get_column(2) };
+	const Vector3 columns_b[3] = { p_transform_b.basis.get_column(0), p_transform_b.basis.get_column(1), p_transform_b.basis.get_column(2) };
+
 	// test faces of A
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
+		Vector3 axis = columns_a[i].normalized();
 
 		if (!separator.test_axis(axis)) {
 			return;
@@ -1092,7 +1096,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	// test faces of B
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
+		Vector3 axis = columns_b[i].normalized();
 
 		if (!separator.test_axis(axis)) {
 			return;
@@ -1102,7 +1106,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	// test combined edges
 	for (int i = 0; i < 3; i++) {
 		for (int j = 0; j < 3; j++) {
-			Vector3 axis = p_transform_a.basis.get_column(i).cross(p_transform_b.basis.get_column(j));
+			Vector3 axis = columns_a[i].cross(columns_b[j]);
 
 			if (Math::is_zero_approx(axis.length_squared())) {
 				continue;
@@ -1148,14 +1152,14 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 
 		for (int i = 0; i < 3; i++) {
 			//a ->b
-			Vector3 axis_a = p_transform_a.basis.get_column(i);
+			const Vector3 &axis_a = columns_a[i];
 
 			if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
 				return;
 			}
 
 			//b ->a
-			Vector3 axis_b = p_transform_b.basis.get_column(i);
+			const Vector3 &axis_b = columns_b[i];
 
 			if (!separator.test_axis(axis_ab.cross(axis_b).cross(axis_b).normalized())) {
 				return;
@@ -1204,22 +1208,23 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 	}
 
 	// points of A, capsule cylinder
-	// this sure could be made faster somehow..
+	// The scaled box axes are computed once, each corner is then just a sum with different signs.
+
+	const Vector3 &half_extents = box_A->get_half_extents();
+	const Vector3 extent_x = p_transform_a.basis.get_column(0) * half_extents.x;
+	const Vector3 extent_y = p_transform_a.basis.get_column(1) * half_extents.y;
+	const Vector3 extent_z = p_transform_a.basis.get_column(2) * half_extents.z;
+	const Plane cyl_plane(cyl_axis);
 
 	for (int i = 0; i < 2; i++) {
+		const Vector3 point_x = p_transform_a.origin + (i ? extent_x : -extent_x);
 		for (int j = 0; j < 2; j++) {
+			const Vector3 point_xy = point_x + (j ? extent_y : -extent_y);
 			for (int k = 0; k < 2; k++) {
-				Vector3 he = box_A->get_half_extents();
-				he.x *= (i * 2 - 1);
-				he.y *= (j * 2 - 1);
-				he.z *= (k * 2 - 1);
-				Vector3 point = p_transform_a.origin;
-				for (int l = 0; l < 3; l++) {
-					point += p_transform_a.basis.get_column(l) * he[l];
-				}
+				const Vector3 point = point_xy + (k ? extent_z : -extent_z);
 
 				//Vector3 axis = (point - cyl_axis * cyl_axis.dot(point)).normalized();
-				Vector3 axis = Plane(cyl_axis).project(point).normalized();
+				Vector3 axis = cyl_plane.project(point).normalized();
 
 				if (!separator.test_axis(axis)) {
 					return;
@@ -1230,9 +1235,9 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 
 	// capsule balls, edges of A
 
-	for (int i = 0; i < 2; i++) {
-		Vector3 capsule_axis = p_transform_b.basis.get_column(1) * (capsule_B->get_height() * 0.5 - capsule_B->get_radius());
+	const Vector3 capsule_axis = p_transform_b.basis.get_column(1) * (capsule_B->get_height() * 0.5 - capsule_B->get_radius());
 
+	for (int i = 0; i < 2; i++) {
 		Vector3 sphere_pos = p_transform_b.origin + ((i == 0) ? capsule_axis : -capsule_axis);
 
 		Vector3 cnormal = p_transform_a.xform_inv(sphere_pos);
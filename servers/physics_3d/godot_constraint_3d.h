@@ -75,6 +75,16 @@ public:
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	// Whether pre_solve() only modifies this constraint and bodies from its own island,
+	// which allows different islands to be pre-solved on separate threads.
+	virtual bool is_pre_solve_thread_safe() const { return true; }
+
+	// Data kept across steps, saved and restored along with GodotSpace3D snapshots.
+	// load_snapshot() returns false if the data belongs to another constraint.
+	virtual uint32_t get_snapshot_size() const { return 0; }
+	virtual void save_snapshot(uint8_t *r_data) const {}
+	virtual bool load_snapshot(const uint8_t *p_data) { return false; }
+
 	virtual ~GodotConstraint3D() {}
 };
 
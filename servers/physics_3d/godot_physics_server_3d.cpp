@@ -214,6 +214,18 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer3D::space_save_snapshot(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	return space->save_snapshot();
+}
+
+bool GodotPhysicsServer3D::space_load_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	return space->load_snapshot(p_snapshot);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1639,11 +1651,13 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 
 	island_count = 0;
 	active_objects = 0;
+	sleeping_objects = 0;
 	collision_pairs = 0;
 	for (const GodotSpace3D *E : active_spaces) {
 		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
+		sleeping_objects += E->get_sleeping_objects();
 		collision_pairs += E->get_collision_pairs();
 	}
 #endif
@@ -1725,6 +1739,9 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_SLEEPING_OBJECTS: {
+			return sleeping_objects;
+		} break;
 	}
 
 	return 0;
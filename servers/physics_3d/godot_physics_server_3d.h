@@ -47,6 +47,7 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 
 	int island_count = 0;
 	int active_objects = 0;
+	int sleeping_objects = 0;
 	int collision_pairs = 0;
 
 	bool using_threads = false;
@@ -117,6 +118,9 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_save_snapshot(RID p_space) const override;
+	virtual bool space_load_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
@@ -33,6 +33,7 @@
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/sort_array.h"
 
 // GodotHeightMapShape3D is based on Bullet btHeightfieldTerrainShape.
@@ -837,16 +838,21 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		r_min = p_normal.dot(p_transform.xform(get_support(-n)));
 		r_max = p_normal.dot(p_transform.xform(get_support(n)));
 	} else {
-		for (uint32_t i = 0; i < vertex_count; i++) {
-			real_t d = p_normal.dot(p_transform.xform(vrts[i]));
-
-			if (i == 0 || d > r_max) {
-				r_max = d;
-			}
-			if (i == 0 || d < r_min) {
-				r_min = d;
-			}
+		// Project in local space, dot(n, B * v + o) == dot(B^T * n, v) + dot(n, o),
+		// which avoids transforming every vertex.
+		const Vector3 local_normal = p_transform.basis.xform_inv(p_normal);
+		real_t min_d = local_normal.dot(vrts[0]);
+		real_t max_d = min_d;
+
+		for (uint32_t i = 1; i < vertex_count; i++) {
+			real_t d = local_normal.dot(vrts[i]);
+			min_d = MIN(min_d, d);
+			max_d = MAX(max_d, d);
 		}
+
+		real_t offset = p_normal.dot(p_transform.origin);
+		r_min = min_d + offset;
+		r_max = max_d + offset;
 	}
 }
 
@@ -1348,12 +1354,17 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
 	const BVH *params_bvh = &p_params->bvh[p_idx];
 
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
+	// Cheap rejection against the segment bounds before the exact test.
+	if (!params_bvh->intersects(p_params->quantized_min, p_params->quantized_max)) {
+		return;
+	}
+
+	if (!_dequantize_aabb(*params_bvh).intersects_segment(p_params->from, p_params->to)) {
 		return;
 	}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
+	if (params_bvh->is_leaf()) {
+		const Face *f = &p_params->faces[params_bvh->data];
 		GodotFaceShape3D *face = p_params->face;
 		face->normal = f->normal;
 		face->vertex[0] = p_params->vertices[f->indices[0]];
@@ -1362,7 +1373,7 @@ void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_
 
 		Vector3 res;
 		Vector3 normal;
-		int face_index = params_bvh->face_index;
+		int face_index = params_bvh->data;
 		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
 			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
 			if ((d > 0) && (d < p_params->min_d)) {
@@ -1374,12 +1385,8 @@ void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_
 			}
 		}
 	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
-		}
+		_cull_segment(p_idx + 1, p_params);
+		_cull_segment(params_bvh->get_right(), p_params);
 	}
 }
 
@@ -1401,6 +1408,10 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 	params.to = p_end;
 	params.dir = (p_end - p_begin).normalized();
 
+	AABB segment_aabb(p_begin, Vector3());
+	segment_aabb.expand_to(p_end);
+	_quantize_aabb(segment_aabb, params.quantized_min, params.quantized_max);
+
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
@@ -1431,31 +1442,36 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
 	const BVH *params_bvh = &p_params->bvh[p_idx];
 
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
+	if (!params_bvh->intersects(p_params->quantized_min, p_params->quantized_max)) {
 		return false;
 	}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
+	if (params_bvh->is_leaf()) {
+		const Face *f = &p_params->faces[params_bvh->data];
 		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
 		face->vertex[0] = p_params->vertices[f->indices[0]];
 		face->vertex[1] = p_params->vertices[f->indices[1]];
 		face->vertex[2] = p_params->vertices[f->indices[2]];
+
+		// Quantized bounds are conservative, check the exact face bounds before reporting it.
+		AABB face_aabb(face->vertex[0], Vector3());
+		face_aabb.expand_to(face->vertex[1]);
+		face_aabb.expand_to(face->vertex[2]);
+		if (!p_params->aabb.intersects(face_aabb)) {
+			return false;
+		}
+
+		face->normal = f->normal;
 		if (p_params->callback(p_params->userdata, face)) {
 			return true;
 		}
 	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
-			}
+		if (_cull(p_idx + 1, p_params)) {
+			return true;
 		}
 
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
-			}
+		if (_cull(params_bvh->get_right(), p_params)) {
+			return true;
 		}
 	}
 
@@ -1481,6 +1497,7 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 
 	_CullParams params;
 	params.aabb = local_aabb;
+	_quantize_aabb(local_aabb, params.quantized_min, params.quantized_max);
 	params.face = &face;
 	params.faces = fr;
 	params.vertices = vr;
@@ -1586,24 +1603,17 @@ _Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int
 void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
 	int idx = p_idx;
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
-
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+	_quantize_aabb(p_bvh_tree->aabb, p_bvh_array[idx].min, p_bvh_array[idx].max);
 
+	if (p_bvh_tree->face_index >= 0) {
+		p_bvh_array[idx].data = p_bvh_tree->face_index;
 	} else {
-		p_bvh_array[p_idx].left = -1;
-	}
+		// Internal nodes always have both children, the left one is stored right after its parent.
+		++p_idx;
+		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
+		p_bvh_array[idx].data = ~(++p_idx);
 		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].right = -1;
 	}
 
 	memdelete(p_bvh_tree);
@@ -1628,9 +1638,10 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 	faces.resize(src_face_count);
 	Face *facesw = faces.ptrw();
 
-	vertices.resize(src_face_count * 3);
-
-	Vector3 *verticesw = vertices.ptrw();
+	// Faces of a trimesh share most of their vertices, only store each position once.
+	HashMap<Vector3, int> vertex_indices;
+	vertex_indices.reserve(src_face_count);
+	LocalVector<Vector3> unique_vertices;
 
 	AABB _aabb;
 
@@ -1640,13 +1651,17 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 		bvh_arrayw[i].aabb = face.get_aabb();
 		bvh_arrayw[i].center = bvh_arrayw[i].aabb.get_center();
 		bvh_arrayw[i].face_index = i;
-		facesw[i].indices[0] = i * 3 + 0;
-		facesw[i].indices[1] = i * 3 + 1;
-		facesw[i].indices[2] = i * 3 + 2;
+		for (int j = 0; j < 3; j++) {
+			HashMap<Vector3, int>::Iterator E = vertex_indices.find(face.vertex[j]);
+			if (E) {
+				facesw[i].indices[j] = E->value;
+			} else {
+				facesw[i].indices[j] = unique_vertices.size();
+				vertex_indices.insert(face.vertex[j], unique_vertices.size());
+				unique_vertices.push_back(face.vertex[j]);
+			}
+		}
 		facesw[i].normal = face.get_plane().normal;
-		verticesw[i * 3 + 0] = face.vertex[0];
-		verticesw[i * 3 + 1] = face.vertex[1];
-		verticesw[i * 3 + 2] = face.vertex[2];
 		if (i == 0) {
 			_aabb = bvh_arrayw[i].aabb;
 		} else {
@@ -1654,10 +1669,25 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 		}
 	}
 
+	vertices.resize(unique_vertices.size());
+	memcpy(vertices.ptrw(), unique_vertices.ptr(), sizeof(Vector3) * unique_vertices.size());
+
+	bvh_origin = _aabb.position;
+	for (int i = 0; i < 3; i++) {
+		if (_aabb.size[i] > CMP_EPSILON) {
+			bvh_quantize_scale[i] = UINT16_MAX / _aabb.size[i];
+			bvh_dequantize_scale[i] = _aabb.size[i] / UINT16_MAX;
+		} else {
+			// Flat along this axis, every node spans the whole (empty) range.
+			bvh_quantize_scale[i] = 0.0;
+			bvh_dequantize_scale[i] = 0.0;
+		}
+	}
+
 	int count = 0;
 	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
 
-	bvh.resize(count + 1);
+	bvh.resize(count);
 
 	BVH *bvh_arrayw2 = bvh.ptrw();
 
@@ -2023,6 +2053,99 @@ void GodotHeightMapShape3D::_get_cell(const Vector3 &p_point, int &r_x, int &r_y
 	r_z = (clamped_point.z < 0.0) ? (clamped_point.z - 0.5) : (clamped_point.z + 0.5);
 }
 
+struct _HeightmapCullParams {
+	const GodotHeightMapShape3D *heightmap = nullptr;
+	GodotConcaveShape3D::QueryCallback callback = nullptr;
+	void *userdata = nullptr;
+	GodotFaceShape3D *face = nullptr;
+
+	// Cells to walk, end excluded.
+	int start_x = 0;
+	int end_x = 0;
+	int start_z = 0;
+	int end_z = 0;
+
+	real_t min_y = 0.0;
+	real_t max_y = 0.0;
+};
+
+_FORCE_INLINE_ bool _heightmap_cull_face(_HeightmapCullParams &p_params) {
+	GodotFaceShape3D *face = p_params.face;
+
+	// Faces entirely above or below the query can't touch it.
+	const real_t face_min_y = MIN(face->vertex[0].y, MIN(face->vertex[1].y, face->vertex[2].y));
+	const real_t face_max_y = MAX(face->vertex[0].y, MAX(face->vertex[1].y, face->vertex[2].y));
+	if (face_min_y > p_params.max_y || face_max_y < p_params.min_y) {
+		return false;
+	}
+
+	face->normal = Plane(face->vertex[0], face->vertex[1], face->vertex[2]).normal;
+	return p_params.callback(p_params.userdata, face);
+}
+
+bool _heightmap_cull_cells(_HeightmapCullParams &p_params, int p_start_x, int p_end_x, int p_start_z, int p_end_z) {
+	const GodotHeightMapShape3D *heightmap = p_params.heightmap;
+	GodotFaceShape3D *face = p_params.face;
+
+	for (int z = p_start_z; z < p_end_z; z++) {
+		for (int x = p_start_x; x < p_end_x; x++) {
+			// First triangle.
+			heightmap->_get_point(x, z, face->vertex[0]);
+			heightmap->_get_point(x + 1, z, face->vertex[1]);
+			heightmap->_get_point(x, z + 1, face->vertex[2]);
+			if (_heightmap_cull_face(p_params)) {
+				return true;
+			}
+
+			// Second triangle.
+			face->vertex[0] = face->vertex[1];
+			heightmap->_get_point(x + 1, z + 1, face->vertex[1]);
+			if (_heightmap_cull_face(p_params)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+// Walks down the bounds pyramid, skipping whole regions whose height range misses the query.
+bool _heightmap_cull_bounds(_HeightmapCullParams &p_params, int p_level, int p_x, int p_z) {
+	const GodotHeightMapShape3D::Range &range = p_params.heightmap->_get_bounds_range(p_level, p_x, p_z);
+	if (range.min > p_params.max_y || range.max < p_params.min_y) {
+		return false;
+	}
+
+	const int cell_size = GodotHeightMapShape3D::BOUNDS_CHUNK_SIZE << p_level;
+	const int start_x = MAX(p_x * cell_size, p_params.start_x);
+	const int end_x = MIN((p_x + 1) * cell_size, p_params.end_x);
+	const int start_z = MAX(p_z * cell_size, p_params.start_z);
+	const int end_z = MIN((p_z + 1) * cell_size, p_params.end_z);
+	if (start_x >= end_x || start_z >= end_z) {
+		return false;
+	}
+
+	if (p_level == 0) {
+		return _heightmap_cull_cells(p_params, start_x, end_x, start_z, end_z);
+	}
+
+	int child_width = 0;
+	int child_depth = 0;
+	p_params.heightmap->_get_bounds_level_size(p_level - 1, child_width, child_depth);
+
+	const int child_end_x = MIN(p_x * 2 + 2, child_width);
+	const int child_end_z = MIN(p_z * 2 + 2, child_depth);
+	for (int z = p_z * 2; z < child_end_z; z++) {
+		for (int x = p_x * 2; x < child_end_x; x++) {
+			if (_heightmap_cull_bounds(p_params, p_level - 1, x, z)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
 	if (heights.is_empty()) {
 		return;
@@ -2044,35 +2167,29 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 		aabb_max[i]++;
 	}
 
-	int start_x = MAX(0, aabb_min[0]);
-	int end_x = MIN(width - 1, aabb_max[0]);
-	int start_z = MAX(0, aabb_min[2]);
-	int end_z = MIN(depth - 1, aabb_max[2]);
-
 	GodotFaceShape3D face;
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	for (int z = start_z; z < end_z; z++) {
-		for (int x = start_x; x < end_x; x++) {
-			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
-			}
-
-			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
-			}
-		}
+	_HeightmapCullParams params;
+	params.heightmap = this;
+	params.callback = p_callback;
+	params.userdata = p_userdata;
+	params.face = &face;
+	params.start_x = MAX(0, aabb_min[0]);
+	params.end_x = MIN(width - 1, aabb_max[0]);
+	params.start_z = MAX(0, aabb_min[2]);
+	params.end_z = MIN(depth - 1, aabb_max[2]);
+	params.min_y = p_local_aabb.position.y;
+	params.max_y = p_local_aabb.position.y + p_local_aabb.size.y;
+
+	if (bounds_grid.is_empty()) {
+		_heightmap_cull_cells(params, params.start_x, params.end_x, params.start_z, params.end_z);
+		return;
 	}
+
+	// The top of the pyramid is a single cell, or the chunk grid itself if it's already that small.
+	_heightmap_cull_bounds(params, bounds_pyramid.size(), 0, 0);
 }
 
 Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -2087,6 +2204,7 @@ Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
 
 void GodotHeightMapShape3D::_build_accelerator() {
 	bounds_grid.clear();
+	bounds_pyramid.clear();
 
 	bounds_grid_width = width / BOUNDS_CHUNK_SIZE;
 	bounds_grid_depth = depth / BOUNDS_CHUNK_SIZE;
@@ -2152,6 +2270,38 @@ void GodotHeightMapShape3D::_build_accelerator() {
 			bounds_grid[cx + cz * bounds_grid_width] = r;
 		}
 	}
+
+	// Build coarser levels until a single cell covers the whole heightmap.
+	int level_width = bounds_grid_width;
+	int level_depth = bounds_grid_depth;
+	while (level_width > 1 || level_depth > 1) {
+		const int child_level = bounds_pyramid.size();
+
+		BoundsLevel level;
+		level.width = (level_width + 1) / 2;
+		level.depth = (level_depth + 1) / 2;
+		level.ranges.resize(level.width * level.depth);
+
+		for (int z = 0; z < level.depth; ++z) {
+			for (int x = 0; x < level.width; ++x) {
+				Range r = _get_bounds_range(child_level, x * 2, z * 2);
+				const int child_end_x = MIN(x * 2 + 2, level_width);
+				const int child_end_z = MIN(z * 2 + 2, level_depth);
+				for (int child_z = z * 2; child_z < child_end_z; ++child_z) {
+					for (int child_x = x * 2; child_x < child_end_x; ++child_x) {
+						const Range &child = _get_bounds_range(child_level, child_x, child_z);
+						r.min = MIN(r.min, child.min);
+						r.max = MAX(r.max, child.max);
+					}
+				}
+				level.ranges[x + z * level.width] = r;
+			}
+		}
+
+		level_width = level.width;
+		level_depth = level.depth;
+		bounds_pyramid.push_back(level);
+	}
 }
 
 void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
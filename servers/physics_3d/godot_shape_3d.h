@@ -316,18 +316,48 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
+	// Nodes are stored depth-first, so the left child of an internal node always follows it.
+	// Bounds are quantized to 16 bits relative to the shape AABB, and rounded outwards.
 	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		// Face index for leaves, bitwise negation of the right child index for internal nodes.
+		int32_t data = 0;
+
+		_FORCE_INLINE_ bool is_leaf() const { return data >= 0; }
+		_FORCE_INLINE_ int get_right() const { return ~data; }
+
+		_FORCE_INLINE_ bool intersects(const uint16_t p_min[3], const uint16_t p_max[3]) const {
+			return min[0] <= p_max[0] && max[0] >= p_min[0] &&
+					min[1] <= p_max[1] && max[1] >= p_min[1] &&
+					min[2] <= p_max[2] && max[2] >= p_min[2];
+		}
 	};
 
 	Vector<BVH> bvh;
+	Vector3 bvh_origin;
+	Vector3 bvh_quantize_scale;
+	Vector3 bvh_dequantize_scale;
+
+	_FORCE_INLINE_ void _quantize_aabb(const AABB &p_aabb, uint16_t r_min[3], uint16_t r_max[3]) const {
+		for (int i = 0; i < 3; i++) {
+			const real_t from = Math::floor((p_aabb.position[i] - bvh_origin[i]) * bvh_quantize_scale[i]) - 1.0;
+			const real_t to = Math::ceil((p_aabb.position[i] + p_aabb.size[i] - bvh_origin[i]) * bvh_quantize_scale[i]) + 1.0;
+			r_min[i] = (uint16_t)CLAMP(from, (real_t)0.0, (real_t)UINT16_MAX);
+			r_max[i] = (uint16_t)CLAMP(to, (real_t)0.0, (real_t)UINT16_MAX);
+		}
+	}
+
+	_FORCE_INLINE_ AABB _dequantize_aabb(const BVH &p_node) const {
+		const Vector3 min(p_node.min[0], p_node.min[1], p_node.min[2]);
+		const Vector3 max(p_node.max[0], p_node.max[1], p_node.max[2]);
+		return AABB(bvh_origin + min * bvh_dequantize_scale, (max - min) * bvh_dequantize_scale);
+	}
 
 	struct _CullParams {
 		AABB aabb;
+		uint16_t quantized_min[3] = {};
+		uint16_t quantized_max[3] = {};
 		QueryCallback callback = nullptr;
 		void *userdata = nullptr;
 		const Face *faces = nullptr;
@@ -340,6 +370,8 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		Vector3 from;
 		Vector3 to;
 		Vector3 dir;
+		uint16_t quantized_min[3] = {};
+		uint16_t quantized_max[3] = {};
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
 		const BVH *bvh = nullptr;
@@ -400,10 +432,38 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 
 	static const int BOUNDS_CHUNK_SIZE = 16;
 
+	// Coarser levels above the chunk grid, each cell merges 2x2 cells of the level below.
+	// The last level is a single cell covering the whole heightmap.
+	struct BoundsLevel {
+		LocalVector<Range> ranges;
+		int width = 0;
+		int depth = 0;
+	};
+	LocalVector<BoundsLevel> bounds_pyramid;
+
 	_FORCE_INLINE_ const Range &_get_bounds_chunk(int p_x, int p_z) const {
 		return bounds_grid[(p_z * bounds_grid_width) + p_x];
 	}
 
+	// Level 0 is the chunk grid.
+	_FORCE_INLINE_ const Range &_get_bounds_range(int p_level, int p_x, int p_z) const {
+		if (p_level == 0) {
+			return _get_bounds_chunk(p_x, p_z);
+		}
+		const BoundsLevel &level = bounds_pyramid[p_level - 1];
+		return level.ranges[(p_z * level.width) + p_x];
+	}
+
+	_FORCE_INLINE_ void _get_bounds_level_size(int p_level, int &r_width, int &r_depth) const {
+		if (p_level == 0) {
+			r_width = bounds_grid_width;
+			r_depth = bounds_grid_depth;
+		} else {
+			r_width = bounds_pyramid[p_level - 1].width;
+			r_depth = bounds_pyramid[p_level - 1].depth;
+		}
+	}
+
 	_FORCE_INLINE_ real_t _get_height(int p_x, int p_z) const {
 		return heights[(p_z * width) + p_x];
 	}
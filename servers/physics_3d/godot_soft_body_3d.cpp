@@ -32,7 +32,9 @@
 
 #include "godot_space_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
 #include "servers/rendering_server.h"
 
@@ -54,10 +56,32 @@ subject to the following restrictions:
 */
 ///btSoftBody implementation by Nathanael Presson
 
+// Soft bodies with fewer nodes or links than this are processed on the physics thread only.
+#define SOFT_BODY_PARALLEL_MIN_ELEMENTS 2048
+// Minimum amount of nodes or links handed to a single worker task.
+#define SOFT_BODY_PARALLEL_MIN_TASK_ELEMENTS 256
+// Link batches are tracked per node as a bit mask.
+#define SOFT_BODY_LINK_BATCH_MAX 64
+
+// Calls `p_func(from, to)` over ranges covering `[0, p_count)`, spread across the WorkerThreadPool
+// when there is enough work. Elements must be independent from each other.
+template <typename F>
+static void _process_range(uint32_t p_count, const F &p_func) {
+	if (p_count < SOFT_BODY_PARALLEL_MIN_ELEMENTS) {
+		p_func(0, p_count);
+		return;
+	}
+	WorkerThreadPool::process_ranges(p_count, SOFT_BODY_PARALLEL_MIN_TASK_ELEMENTS, p_func);
+}
+
 GodotSoftBody3D::GodotSoftBody3D() :
 		GodotCollisionObject3D(TYPE_SOFT_BODY),
 		active_list(this) {
 	_set_static(false);
+
+	// Batches change the order in which links are solved, so they are used even without
+	// worker threads when stepping has to give the same results on every machine.
+	link_batches_enabled = WorkerThreadPool::get_singleton()->get_thread_count() > 1 || GLOBAL_GET("physics/3d/solver/deterministic_stepping");
 }
 
 void GodotSoftBody3D::_shapes_changed() {
@@ -169,26 +193,40 @@ void GodotSoftBody3D::update_rendering_server(PhysicsServer3DRenderingServerHand
 }
 
 void GodotSoftBody3D::update_normals_and_centroids() {
+	// Face normals are computed in parallel, but accumulated into nodes serially since faces share nodes.
+	_process_range(faces.size(), [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			Face &face = faces[i];
+			face.normal = vec3_cross(face.n[0]->x - face.n[2]->x, face.n[0]->x - face.n[1]->x);
+			face.centroid = 0.33333333333 * (face.n[0]->x + face.n[1]->x + face.n[2]->x);
+		}
+	});
+
 	for (Node &node : nodes) {
 		node.n = Vector3();
 	}
 
 	for (Face &face : faces) {
-		const Vector3 n = vec3_cross(face.n[0]->x - face.n[2]->x, face.n[0]->x - face.n[1]->x);
-		face.n[0]->n += n;
-		face.n[1]->n += n;
-		face.n[2]->n += n;
-		face.normal = n;
-		face.normal.normalize();
-		face.centroid = 0.33333333333 * (face.n[0]->x + face.n[1]->x + face.n[2]->x);
+		face.n[0]->n += face.normal;
+		face.n[1]->n += face.normal;
+		face.n[2]->n += face.normal;
 	}
 
-	for (Node &node : nodes) {
-		real_t len = node.n.length();
-		if (len > CMP_EPSILON) {
-			node.n /= len;
+	_process_range(faces.size(), [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			faces[i].normal.normalize();
 		}
-	}
+	});
+
+	_process_range(nodes.size(), [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			Node &node = nodes[i];
+			real_t len = node.n.length();
+			if (len > CMP_EPSILON) {
+				node.n /= len;
+			}
+		}
+	});
 }
 
 void GodotSoftBody3D::update_bounds() {
@@ -816,6 +854,8 @@ void GodotSoftBody3D::reoptimize_link_order() {
 		}
 	}
 
+	link_batches_dirty = true;
+
 	// Delete the temporary buffers.
 	memdelete_arr(node_written_at);
 	memdelete_arr(link_dep_A);
@@ -840,6 +880,7 @@ void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 	link.rl = (node1->x - node2->x).length();
 
 	links.push_back(link);
+	link_batches_dirty = true;
 }
 
 void GodotSoftBody3D::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3) {
@@ -1034,16 +1075,19 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	real_t clamp_delta_v = max_displacement * inv_delta;
 
 	// Integrate.
-	for (Node &node : nodes) {
-		node.q = node.x;
-		Vector3 delta_v = node.f * node.im * p_delta;
-		for (int c = 0; c < 3; c++) {
-			delta_v[c] = CLAMP(delta_v[c], -clamp_delta_v, clamp_delta_v);
+	_process_range(nodes.size(), [this, p_delta, clamp_delta_v](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			Node &node = nodes[i];
+			node.q = node.x;
+			Vector3 delta_v = node.f * node.im * p_delta;
+			for (int c = 0; c < 3; c++) {
+				delta_v[c] = CLAMP(delta_v[c], -clamp_delta_v, clamp_delta_v);
+			}
+			node.v += delta_v;
+			node.x += node.v * p_delta;
+			node.f = Vector3();
 		}
-		node.v += delta_v;
-		node.x += node.v * p_delta;
-		node.f = Vector3();
-	}
+	});
 
 	// Bounds and tree update.
 	update_bounds();
@@ -1070,15 +1114,21 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	const real_t inv_delta = 1.0 / p_delta;
 
-	for (Link &link : links) {
-		link.c3 = link.n[1]->q - link.n[0]->q;
-		link.c2 = 1 / (link.c3.length_squared() * link.c0);
-	}
+	_process_range(links.size(), [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			Link &link = links[i];
+			link.c3 = link.n[1]->q - link.n[0]->q;
+			link.c2 = 1 / (link.c3.length_squared() * link.c0);
+		}
+	});
 
 	// Solve velocities.
-	for (Node &node : nodes) {
-		node.x = node.q + node.v * p_delta;
-	}
+	_process_range(nodes.size(), [this, p_delta](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			Node &node = nodes[i];
+			node.x = node.q + node.v * p_delta;
+		}
+	});
 
 	// Solve positions.
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
@@ -1086,31 +1136,111 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 		solve_links(1.0, ti);
 	}
 	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (Node &node : nodes) {
-		node.x += node.bv * p_delta;
-		node.bv = Vector3();
+	_process_range(nodes.size(), [this, p_delta, vc](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			Node &node = nodes[i];
+			node.x += node.bv * p_delta;
+			node.bv = Vector3();
 
-		node.v = (node.x - node.q) * vc;
+			node.v = (node.x - node.q) * vc;
 
-		node.q = node.x;
-	}
+			node.q = node.x;
+		}
+	});
 
 	update_normals_and_centroids();
 }
 
-void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (Link &link : links) {
-		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
-			const real_t len = del.length_squared();
-			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+_FORCE_INLINE_ void GodotSoftBody3D::_solve_link(Link &p_link, real_t p_kst) {
+	if (p_link.c0 > 0) {
+		Node &node_a = *p_link.n[0];
+		Node &node_b = *p_link.n[1];
+		const Vector3 del = node_b.x - node_a.x;
+		const real_t len = del.length_squared();
+		if (p_link.c1 + len > CMP_EPSILON) {
+			const real_t k = ((p_link.c1 - len) / (p_link.c0 * (p_link.c1 + len))) * p_kst;
+			node_a.x -= del * (k * node_a.im);
+			node_b.x += del * (k * node_b.im);
+		}
+	}
+}
+
+void GodotSoftBody3D::update_link_batches() {
+	link_batches_dirty = false;
+	link_batch_order.clear();
+	link_batch_offsets.clear();
+
+	const uint32_t link_count = links.size();
+	if (link_count < SOFT_BODY_PARALLEL_MIN_ELEMENTS) {
+		return;
+	}
+
+	// Greedy coloring in link order: each link goes to the first batch none of its nodes is part of yet.
+	LocalVector<uint64_t> node_batch_masks;
+	node_batch_masks.resize(nodes.size());
+	memset(node_batch_masks.ptr(), 0, sizeof(uint64_t) * node_batch_masks.size());
+
+	LocalVector<uint32_t> link_batch;
+	link_batch.resize(link_count);
+	uint32_t batch_sizes[SOFT_BODY_LINK_BATCH_MAX + 1] = {};
+
+	const Node *first_node = nodes.ptr();
+	for (uint32_t i = 0; i < link_count; i++) {
+		const uint32_t node_a = links[i].n[0] - first_node;
+		const uint32_t node_b = links[i].n[1] - first_node;
+		const uint64_t used = node_batch_masks[node_a] | node_batch_masks[node_b];
+
+		uint32_t batch = SOFT_BODY_LINK_BATCH_MAX;
+		if (used != UINT64_MAX) {
+			batch = 0;
+			while (used & (uint64_t(1) << batch)) {
+				batch++;
 			}
+			node_batch_masks[node_a] |= uint64_t(1) << batch;
+			node_batch_masks[node_b] |= uint64_t(1) << batch;
 		}
+		link_batch[i] = batch;
+		batch_sizes[batch]++;
+	}
+
+	link_batch_offsets.resize(SOFT_BODY_LINK_BATCH_MAX + 2);
+	link_batch_offsets[0] = 0;
+	for (uint32_t i = 0; i <= SOFT_BODY_LINK_BATCH_MAX; i++) {
+		link_batch_offsets[i + 1] = link_batch_offsets[i] + batch_sizes[i];
+	}
+
+	// Stable counting sort, links keep their relative order within each batch.
+	LocalVector<uint32_t> write_offsets = link_batch_offsets;
+	link_batch_order.resize(link_count);
+	for (uint32_t i = 0; i < link_count; i++) {
+		link_batch_order[write_offsets[link_batch[i]]++] = i;
+	}
+}
+
+void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
+	if (link_batches_enabled && link_batches_dirty) {
+		update_link_batches();
+	}
+
+	if (!link_batches_enabled || link_batch_order.is_empty()) {
+		for (Link &link : links) {
+			_solve_link(link, kst);
+		}
+		return;
+	}
+
+	for (uint32_t batch = 0; batch < SOFT_BODY_LINK_BATCH_MAX; batch++) {
+		const uint32_t *batch_links = link_batch_order.ptr() + link_batch_offsets[batch];
+		_process_range(link_batch_offsets[batch + 1] - link_batch_offsets[batch], [this, batch_links, kst](uint32_t p_from, uint32_t p_to) {
+			for (uint32_t i = p_from; i < p_to; i++) {
+				_solve_link(links[batch_links[i]], kst);
+			}
+		});
+	}
+
+	// Links that didn't fit in any batch.
+	for (uint32_t i = link_batch_offsets[SOFT_BODY_LINK_BATCH_MAX]; i < link_batch_offsets[SOFT_BODY_LINK_BATCH_MAX + 1]; i++) {
+		_solve_link(links[link_batch_order[i]], kst);
 	}
 }
 
@@ -1222,6 +1352,7 @@ void GodotSoftBody3D::destroy() {
 	nodes.clear();
 	links.clear();
 	faces.clear();
+	link_batches_dirty = true;
 
 	bounds = AABB();
 	deinitialize_shape();
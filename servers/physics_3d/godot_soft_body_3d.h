@@ -94,6 +94,14 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	real_t total_mass = 1.0;
 	real_t inv_total_mass = 1.0;
 
+	// Links grouped in batches that don't share any node, each batch is solved in parallel.
+	// Batch i spans [link_batch_offsets[i], link_batch_offsets[i + 1]) in link_batch_order,
+	// the last batch collects links that didn't fit anywhere else and is solved serially.
+	LocalVector<uint32_t> link_batch_order;
+	LocalVector<uint32_t> link_batch_offsets;
+	bool link_batches_dirty = true;
+	bool link_batches_enabled = false;
+
 	int iteration_count = 5;
 	real_t linear_stiffness = 0.5; // [0,1]
 	real_t pressure_coefficient = 0.0; // [-inf,+inf]
@@ -237,6 +245,8 @@ private:
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
+	static void _solve_link(Link &p_link, real_t p_kst);
+	void update_link_batches();
 	void solve_links(real_t kst, real_t ti);
 
 	void initialize_face_tree();
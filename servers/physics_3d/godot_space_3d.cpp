@@ -34,8 +34,11 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
+// Smaller ray batches are cheaper to run on the calling thread.
+#define INTERSECT_RAYS_MIN_THREADED 64
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
@@ -105,16 +108,14 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results) {
 	Vector3 begin, end;
 	Vector3 normal;
 	begin = p_parameters.from;
 	end = p_parameters.to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_query_subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -126,21 +127,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(r_query_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_query_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = r_query_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_query_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -205,6 +206,43 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	return _intersect_ray(p_parameters, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_task(uint32_t p_index, RayBatch *p_batch) {
+	// The shared query buffers of the space can't be used from several threads.
+	GodotCollisionObject3D *query_results[GodotSpace3D::INTERSECTION_QUERY_MAX];
+	int query_subindex_results[GodotSpace3D::INTERSECTION_QUERY_MAX];
+	p_batch->collided[p_index] = _intersect_ray(p_batch->parameters[p_index], p_batch->results[p_index], query_results, query_subindex_results);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_collided) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_count < INTERSECT_RAYS_MIN_THREADED || pool->get_thread_count() <= 1 || pool->get_thread_index() != -1) {
+		// Not worth dispatching, or already running on a worker thread.
+		for (int i = 0; i < p_count; i++) {
+			r_collided[i] = _intersect_ray(p_parameters[i], r_results[i], space->intersection_query_results, space->intersection_query_subindex_results);
+		}
+		return;
+	}
+
+	RayBatch batch;
+	batch.parameters = p_parameters;
+	batch.results = r_results;
+	batch.collided = r_collided;
+
+	WorkerThreadPool::GroupID group_task = pool->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_task, &batch, p_count, -1, true, SNAME("Physics3DIntersectRays"));
+	pool->wait_for_group_task_completion(group_task);
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1120,6 +1158,145 @@ const HashSet<GodotCollisionObject3D *> &GodotSpace3D::get_objects() const {
 	return objects;
 }
 
+// Snapshots are raw copies of the simulation state, only meant to be loaded back by the same build.
+#define SNAPSHOT_MAGIC 0x50414e53 // "SNAP"
+
+struct SpaceSnapshotHeader {
+	uint32_t magic = SNAPSHOT_MAGIC;
+	uint32_t body_state_size = sizeof(GodotBody3D::SnapshotState);
+	uint32_t body_count = 0;
+	uint32_t constraint_count = 0;
+};
+
+Vector<uint8_t> GodotSpace3D::save_snapshot() const {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Can't save a snapshot of a space while it's being stepped.");
+
+	// Compute the size first, to write everything in a single allocation.
+	SpaceSnapshotHeader header;
+	uint64_t size = sizeof(SpaceSnapshotHeader);
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(E);
+		header.body_count++;
+		size += sizeof(uint64_t) + sizeof(GodotBody3D::SnapshotState);
+
+		for (const KeyValue<GodotConstraint3D *, int> &C : body->get_constraint_map()) {
+			// Constraints are stored by their first body only.
+			uint32_t constraint_size = C.key->get_snapshot_size();
+			if (C.value == 0 && constraint_size > 0) {
+				header.constraint_count++;
+				size += sizeof(uint64_t) + sizeof(uint32_t) + constraint_size;
+			}
+		}
+	}
+
+	Vector<uint8_t> snapshot;
+	snapshot.resize(size);
+	uint8_t *w = snapshot.ptrw();
+
+	memcpy(w, &header, sizeof(SpaceSnapshotHeader));
+	w += sizeof(SpaceSnapshotHeader);
+
+	GodotBody3D::SnapshotState body_state;
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(E);
+		uint64_t id = body->get_self().get_id();
+		memcpy(w, &id, sizeof(uint64_t));
+		w += sizeof(uint64_t);
+		body->get_snapshot_state(body_state);
+		memcpy(w, &body_state, sizeof(GodotBody3D::SnapshotState));
+		w += sizeof(GodotBody3D::SnapshotState);
+	}
+
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(E);
+		uint64_t id = body->get_self().get_id();
+		for (const KeyValue<GodotConstraint3D *, int> &C : body->get_constraint_map()) {
+			uint32_t constraint_size = C.key->get_snapshot_size();
+			if (C.value != 0 || constraint_size == 0) {
+				continue;
+			}
+			memcpy(w, &id, sizeof(uint64_t));
+			w += sizeof(uint64_t);
+			memcpy(w, &constraint_size, sizeof(uint32_t));
+			w += sizeof(uint32_t);
+			C.key->save_snapshot(w);
+			w += constraint_size;
+		}
+	}
+
+	return snapshot;
+}
+
+bool GodotSpace3D::load_snapshot(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Can't load a snapshot into a space while it's being stepped.");
+	ERR_FAIL_COND_V(p_snapshot.size() < (int64_t)sizeof(SpaceSnapshotHeader), false);
+
+	const uint8_t *r = p_snapshot.ptr();
+	const uint8_t *end = r + p_snapshot.size();
+
+	SpaceSnapshotHeader header;
+	memcpy(&header, r, sizeof(SpaceSnapshotHeader));
+	r += sizeof(SpaceSnapshotHeader);
+	ERR_FAIL_COND_V_MSG(header.magic != SNAPSHOT_MAGIC || header.body_state_size != sizeof(GodotBody3D::SnapshotState), false, "Invalid physics space snapshot.");
+	ERR_FAIL_COND_V(uint64_t(end - r) < header.body_count * (sizeof(uint64_t) + sizeof(GodotBody3D::SnapshotState)), false);
+
+	HashMap<uint64_t, GodotBody3D *> bodies;
+	bodies.reserve(objects.size());
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			bodies.insert(E->get_self().get_id(), static_cast<GodotBody3D *>(E));
+		}
+	}
+
+	// Bodies removed since the snapshot was taken are skipped, bodies added since then are left untouched.
+	GodotBody3D::SnapshotState body_state;
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		uint64_t id;
+		memcpy(&id, r, sizeof(uint64_t));
+		r += sizeof(uint64_t);
+		memcpy(&body_state, r, sizeof(GodotBody3D::SnapshotState));
+		r += sizeof(GodotBody3D::SnapshotState);
+
+		GodotBody3D **body = bodies.getptr(id);
+		if (body) {
+			(*body)->set_snapshot_state(body_state);
+		}
+	}
+
+	// Pairs that no longer exist lose their cached contacts, new pairs keep theirs.
+	for (uint32_t i = 0; i < header.constraint_count; i++) {
+		ERR_FAIL_COND_V(end - r < (int64_t)(sizeof(uint64_t) + sizeof(uint32_t)), false);
+		uint64_t id;
+		memcpy(&id, r, sizeof(uint64_t));
+		r += sizeof(uint64_t);
+		uint32_t constraint_size;
+		memcpy(&constraint_size, r, sizeof(uint32_t));
+		r += sizeof(uint32_t);
+		ERR_FAIL_COND_V(uint64_t(end - r) < constraint_size, false);
+
+		GodotBody3D **body = bodies.getptr(id);
+		if (body) {
+			for (const KeyValue<GodotConstraint3D *, int> &C : (*body)->get_constraint_map()) {
+				if (C.value == 0 && C.key->get_snapshot_size() == constraint_size && C.key->load_snapshot(r)) {
+					break;
+				}
+			}
+		}
+		r += constraint_size;
+	}
+
+	return true;
+}
+
 void GodotSpace3D::body_add_to_state_query_list(SelfList<GodotBody3D> *p_body) {
 	state_query_list.add(p_body);
 }
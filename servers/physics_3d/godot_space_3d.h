@@ -46,11 +46,21 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		RayResult *results = nullptr;
+		bool *collided = nullptr;
+	};
+
+	bool _intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results);
+	void _intersect_ray_task(uint32_t p_index, RayBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_collided) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
@@ -117,6 +127,8 @@ private:
 
 	int island_count = 0;
 	int active_objects = 0;
+	int sleeping_objects = 0;
+	int rigid_body_count = 0;
 	int collision_pairs = 0;
 
 	RID static_global_body;
@@ -188,6 +200,16 @@ public:
 
 	void set_active_objects(int p_active_objects) { active_objects = p_active_objects; }
 	int get_active_objects() const { return active_objects; }
+	void set_sleeping_objects(int p_sleeping_objects) { sleeping_objects = p_sleeping_objects; }
+	int get_sleeping_objects() const { return sleeping_objects; }
+
+	// Rigid bodies in the space, kept up to date by the bodies so that the step can derive the
+	// sleeping count from the active list alone.
+	void add_rigid_body_count(int p_amount) { rigid_body_count += p_amount; }
+	int get_rigid_body_count() const { return rigid_body_count; }
+
+	Vector<uint8_t> save_snapshot() const;
+	bool load_snapshot(const Vector<uint8_t> &p_snapshot);
 
 	int get_collision_pairs() const { return collision_pairs; }
 
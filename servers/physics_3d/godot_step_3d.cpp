@@ -32,6 +32,7 @@
 
 #include "godot_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
@@ -41,6 +42,11 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+// Batches are tracked per body as a bit mask, the last batch collects whatever doesn't fit.
+#define CONSTRAINT_BATCH_MAX 64
+// Smaller batches aren't worth dispatching to worker threads.
+#define CONSTRAINT_BATCH_MIN_THREADED_SIZE 64
+
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -122,7 +128,10 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	uint32_t valid_constraint_count = 0;
 	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
 		GodotConstraint3D *constraint = p_constraint_island[constraint_index];
-		if (p_constraint_island[constraint_index]->pre_solve(delta)) {
+		if (!constraint->is_pre_solve_thread_safe()) {
+			// Keep it, _pre_solve_island_deferred() takes care of it afterwards.
+			p_constraint_island[valid_constraint_count++] = constraint;
+		} else if (p_constraint_island[constraint_index]->pre_solve(delta)) {
 			// Keep this constraint for solving.
 			p_constraint_island[valid_constraint_count++] = constraint;
 		}
@@ -130,9 +139,30 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep3D::_pre_solve_island_thread_safe(uint32_t p_island_index, void *p_userdata) {
+	_pre_solve_island(constraint_islands[p_island_index]);
+}
+
+void GodotStep3D::_pre_solve_island_deferred(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
+	uint32_t constraint_count = p_constraint_island.size();
+	uint32_t valid_constraint_count = 0;
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = p_constraint_island[constraint_index];
+		if (constraint->is_pre_solve_thread_safe() || constraint->pre_solve(delta)) {
+			// Either already pre-solved, or kept for solving.
+			p_constraint_island[valid_constraint_count++] = constraint;
+		}
+	}
+	p_constraint_island.resize(valid_constraint_count);
+}
+
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
+	if (_is_island_solved_in_parallel(constraint_island)) {
+		return; // Solved afterwards by _solve_island_in_batches().
+	}
+
 	int current_priority = 1;
 
 	uint32_t constraint_count = constraint_island.size();
@@ -158,6 +188,107 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+bool GodotStep3D::_is_island_solved_in_parallel(const LocalVector<GodotConstraint3D *> &p_constraint_island) const {
+	return parallel_island_min_constraints > 0 && p_constraint_island.size() >= parallel_island_min_constraints;
+}
+
+void GodotStep3D::_batch_island_constraints(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	// Greedy coloring in island order: each constraint goes to the first batch none of its
+	// dynamic bodies is part of yet. This only depends on the island order, so the result
+	// is the same regardless of how many threads solve the batches.
+	body_batch_masks.clear();
+	for (LocalVector<GodotConstraint3D *> &batch : constraint_batches) {
+		batch.clear();
+	}
+
+	for (GodotConstraint3D *constraint : p_constraint_island) {
+		uint64_t used_batches = 0;
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			const GodotBody3D *body = constraint->get_body_ptr()[i];
+			if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				const uint64_t *mask = body_batch_masks.getptr(body);
+				if (mask) {
+					used_batches |= *mask;
+				}
+			}
+		}
+		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+			const uint64_t *mask = body_batch_masks.getptr(constraint->get_soft_body_ptr(i));
+			if (mask) {
+				used_batches |= *mask;
+			}
+		}
+
+		uint32_t batch_index = CONSTRAINT_BATCH_MAX - 1;
+		for (uint32_t i = 0; i < CONSTRAINT_BATCH_MAX - 1; i++) {
+			if (!(used_batches & (uint64_t(1) << i))) {
+				batch_index = i;
+				break;
+			}
+		}
+
+		if (batch_index < CONSTRAINT_BATCH_MAX - 1) {
+			// The last batch is solved serially, so it doesn't need to be tracked.
+			const uint64_t batch_bit = uint64_t(1) << batch_index;
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				const GodotBody3D *body = constraint->get_body_ptr()[i];
+				if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+					body_batch_masks[body] |= batch_bit;
+				}
+			}
+			for (int i = 0; i < constraint->get_soft_body_count(); i++) {
+				body_batch_masks[constraint->get_soft_body_ptr(i)] |= batch_bit;
+			}
+		}
+
+		constraint_batches[batch_index].push_back(constraint);
+	}
+}
+
+void GodotStep3D::_solve_batch_constraint(uint32_t p_constraint_index, LocalVector<GodotConstraint3D *> *p_batch) {
+	(*p_batch)[p_constraint_index]->solve(delta);
+}
+
+void GodotStep3D::_solve_island_in_batches(uint32_t p_island_index) {
+	_batch_island_constraints(constraint_islands[p_island_index]);
+
+	int current_priority = 1;
+
+	uint32_t constraint_count = constraint_islands[p_island_index].size();
+	while (constraint_count > 0) {
+		for (int i = 0; i < iterations; i++) {
+			// Go through all iterations, batches are solved one after the other.
+			for (uint32_t batch_index = 0; batch_index < CONSTRAINT_BATCH_MAX; ++batch_index) {
+				LocalVector<GodotConstraint3D *> &batch = constraint_batches[batch_index];
+				if (batch.size() >= CONSTRAINT_BATCH_MIN_THREADED_SIZE && batch_index < CONSTRAINT_BATCH_MAX - 1) {
+					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_batch_constraint, &batch, batch.size(), -1, true, SNAME("Physics3DConstraintSolveBatch"));
+					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+				} else {
+					for (GodotConstraint3D *constraint : batch) {
+						constraint->solve(delta);
+					}
+				}
+			}
+		}
+
+		// Check priority to keep only higher priority constraints.
+		constraint_count = 0;
+		++current_priority;
+		for (LocalVector<GodotConstraint3D *> &batch : constraint_batches) {
+			uint32_t priority_constraint_count = 0;
+			for (uint32_t constraint_index = 0; constraint_index < batch.size(); ++constraint_index) {
+				GodotConstraint3D *constraint = batch[constraint_index];
+				if (constraint->get_priority() >= current_priority) {
+					// Keep this constraint for the next iteration.
+					batch[priority_constraint_count++] = constraint;
+				}
+			}
+			batch.resize(priority_constraint_count);
+			constraint_count += priority_constraint_count;
+		}
+	}
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -202,10 +333,14 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_endtime = 0;
 
 	int active_count = 0;
+	int active_rigid_count = 0;
 
 	const SelfList<GodotBody3D> *b = body_list->first();
 	while (b) {
 		b->self()->integrate_forces(p_delta);
+		if (b->self()->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			active_rigid_count++;
+		}
 		b = b->next();
 		active_count++;
 	}
@@ -220,6 +355,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	p_space->set_active_objects(active_count);
+	p_space->set_sleeping_objects(p_space->get_rigid_body_count() - active_rigid_count);
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -355,9 +491,21 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
+	// Islands don't share dynamic bodies, so they can be pre-solved in parallel. Constraints that
+	// modify state shared between islands (such as areas) are deferred and pre-solved serially.
+	// Both paths pre-solve constraints in the same order, so debugging contacts doesn't change results.
+	if (p_space->is_debugging_contacts()) {
+		// Debug contacts are collected in a single buffer for the whole space, so this can't run on threads.
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_pre_solve_island(constraint_islands[island_index]);
+		}
+	} else {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_pre_solve_island_thread_safe, nullptr, island_count, -1, true, SNAME("Physics3DConstraintPreSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
 	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+		_pre_solve_island_deferred(constraint_islands[island_index]);
 	}
 
 	/* SOLVE CONSTRAINT ISLANDS */
@@ -367,6 +515,17 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	// Large islands were skipped above, solve them one at a time with their constraints spread across threads.
+	parallel_islands.clear();
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		if (_is_island_solved_in_parallel(constraint_islands[island_index])) {
+			parallel_islands.push_back(island_index);
+		}
+	}
+	for (uint32_t island_index : parallel_islands) {
+		_solve_island_in_batches(island_index);
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -412,6 +571,13 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	constraint_batches.resize(CONSTRAINT_BATCH_MAX);
+
+	// Batches change the order in which constraints are solved, so deterministic stepping
+	// uses them even without worker threads to get the same results on every machine.
+	if (WorkerThreadPool::get_singleton()->get_thread_count() > 1 || GLOBAL_GET("physics/3d/solver/deterministic_stepping")) {
+		parallel_island_min_constraints = GLOBAL_GET("physics/3d/solver/parallel_island_min_constraints");
+	}
 }
 
 GodotStep3D::~GodotStep3D() {
@@ -33,6 +33,7 @@
 
 #include "godot_space_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
@@ -45,11 +46,24 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	// Islands with at least this many constraints are split into batches of constraints that
+	// don't share any dynamic body, and each batch is solved in parallel. 0 disables this.
+	uint32_t parallel_island_min_constraints = 0;
+	LocalVector<uint32_t> parallel_islands;
+	LocalVector<LocalVector<GodotConstraint3D *>> constraint_batches;
+	HashMap<const void *, uint64_t> body_batch_masks;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _pre_solve_island_thread_safe(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _pre_solve_island_deferred(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	bool _is_island_solved_in_parallel(const LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _batch_island_constraints(const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_batch_constraint(uint32_t p_constraint_index, LocalVector<GodotConstraint3D *> *p_batch);
+	void _solve_island_in_batches(uint32_t p_island_index);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
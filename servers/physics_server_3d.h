@@ -124,6 +124,7 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(const Ref<PhysicsRayQueryParameters3D> &p_ray_query);
+	TypedArray<Dictionary> _intersect_rays(const TypedArray<PhysicsRayQueryParameters3D> &p_ray_queries);
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
@@ -160,6 +161,9 @@ public:
 	};
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
+	// Runs p_count ray queries, r_results and r_collided must hold p_count elements.
+	// Servers able to run queries concurrently can override this, the default runs them in order.
+	virtual void intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_collided);
 
 	struct ShapeResult {
 		RID rid;
@@ -308,6 +312,10 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Snapshots of the simulation state of a space, meant for rolling back and re-simulating steps.
+	virtual Vector<uint8_t> space_save_snapshot(RID p_space) const = 0;
+	virtual bool space_load_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -807,7 +815,8 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_SLEEPING_OBJECTS
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
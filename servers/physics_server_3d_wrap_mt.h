@@ -118,6 +118,8 @@ public:
 	}
 
 	FUNC2(space_set_debug_contacts, RID, int);
+	FUNC1RC(Vector<uint8_t>, space_save_snapshot, RID);
+	FUNC2R(bool, space_load_snapshot, RID, const Vector<uint8_t> &);
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), Vector<Vector3>());
 		return physics_server_3d->space_get_contacts(p_space);
@@ -221,6 +221,86 @@ TEST_CASE("[Image] Resizing") {
 			"get_size() should return the correct size after resize_to_po2().");
 }
 
+TEST_CASE("[Image] Processing large images") {
+	// Large enough to be split across worker threads; results must match per-pixel reference values.
+	const int size = 512;
+	PackedByteArray data;
+	data.resize(size * size * 4);
+	uint8_t *w = data.ptrw();
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			uint8_t *px = &w[(y * size + x) * 4];
+			px[0] = (x * 7 + y * 3) & 0xFF;
+			px[1] = (x * 13 + y * 5) & 0xFF;
+			px[2] = (x ^ y) & 0xFF;
+			px[3] = (x + y * 11) & 0xFF;
+		}
+	}
+	Ref<Image> source = memnew(Image(size, size, false, Image::FORMAT_RGBA8, data));
+
+	SUBCASE("Mipmap generation") {
+		Ref<Image> image = source->duplicate();
+		image->generate_mipmaps();
+		Ref<Image> mip = image->get_image_from_mipmap(1);
+		REQUIRE(mip->get_size() == Vector2i(size / 2, size / 2));
+		const uint8_t *src = data.ptr();
+		PackedByteArray mip_data = mip->get_data();
+		bool matches = true;
+		for (int y = 0; y < size / 2 && matches; y++) {
+			for (int x = 0; x < size / 2 && matches; x++) {
+				for (int c = 0; c < 4; c++) {
+					const int a = src[((y * 2) * size + x * 2) * 4 + c];
+					const int b = src[((y * 2) * size + x * 2 + 1) * 4 + c];
+					const int d = src[((y * 2 + 1) * size + x * 2) * 4 + c];
+					const int e = src[((y * 2 + 1) * size + x * 2 + 1) * 4 + c];
+					if (mip_data[(y * (size / 2) + x) * 4 + c] != ((a + b + d + e + 2) >> 2)) {
+						matches = false;
+					}
+				}
+			}
+		}
+		CHECK_MESSAGE(matches, "Mipmap pixels should be the average of the four source pixels.");
+	}
+
+	SUBCASE("Nearest resizing") {
+		const int new_size = 384;
+		Ref<Image> image = source->duplicate();
+		image->resize(new_size, new_size, Image::INTERPOLATE_NEAREST);
+		const uint8_t *src = data.ptr();
+		PackedByteArray resized_data = image->get_data();
+		bool matches = true;
+		for (int y = 0; y < new_size && matches; y++) {
+			for (int x = 0; x < new_size && matches; x++) {
+				const int src_x = x * size / new_size;
+				const int src_y = y * size / new_size;
+				for (int c = 0; c < 4; c++) {
+					if (resized_data[(y * new_size + x) * 4 + c] != src[(src_y * size + src_x) * 4 + c]) {
+						matches = false;
+					}
+				}
+			}
+		}
+		CHECK_MESSAGE(matches, "Resized pixels should be sampled from the nearest source pixel.");
+	}
+
+	SUBCASE("Format conversion") {
+		Ref<Image> image = source->duplicate();
+		image->convert(Image::FORMAT_RGB8);
+		const uint8_t *src = data.ptr();
+		PackedByteArray converted_data = image->get_data();
+		REQUIRE(converted_data.size() == size * size * 3);
+		bool matches = true;
+		for (int i = 0; i < size * size && matches; i++) {
+			for (int c = 0; c < 3; c++) {
+				if (converted_data[i * 3 + c] != src[i * 4 + c]) {
+					matches = false;
+				}
+			}
+		}
+		CHECK_MESSAGE(matches, "Converting to RGB8 should keep the color channels of every pixel.");
+	}
+}
+
 TEST_CASE("[Image] Modifying pixels of an image") {
 	Ref<Image> image = memnew(Image(3, 3, false, Image::FORMAT_RGBA8));
 	image->set_pixel(0, 0, Color(1, 1, 1, 1));
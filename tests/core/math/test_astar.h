@@ -32,6 +32,7 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/object/worker_thread_pool.h"
 
 #include "tests/test_macros.h"
 
@@ -85,6 +86,123 @@ TEST_CASE("[AStar3D] ABCX path") {
 	CHECK(path[3] == ABCX::C);
 }
 
+TEST_CASE("[AStar3D] Bidirectional ABC and ABCX paths") {
+	ABCX abcx;
+	abcx.set_bidirectional_search_enabled(true);
+
+	Vector<int64_t> path = abcx.get_id_path(ABCX::A, ABCX::C);
+	REQUIRE(path.size() == 3);
+	CHECK(path[0] == ABCX::A);
+	CHECK(path[1] == ABCX::B);
+	CHECK(path[2] == ABCX::C);
+
+	path = abcx.get_id_path(ABCX::X, ABCX::C);
+	REQUIRE(path.size() == 4);
+	CHECK(path[0] == ABCX::X);
+	CHECK(path[1] == ABCX::A);
+	CHECK(path[2] == ABCX::B);
+	CHECK(path[3] == ABCX::C);
+
+	// X is only reachable from A, not the other way around.
+	abcx.disconnect_points(ABCX::A, ABCX::X, false);
+	CHECK(abcx.get_id_path(ABCX::C, ABCX::X).is_empty());
+	path = abcx.get_id_path(ABCX::C, ABCX::X, true);
+	REQUIRE(path.size() == 2);
+	CHECK(path[1] == ABCX::A);
+}
+
+static real_t get_path_cost(const AStar3D &p_astar, const Vector<int64_t> &p_path) {
+	real_t cost = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		cost += p_astar.get_point_position(p_path[i - 1]).distance_to(p_astar.get_point_position(p_path[i])) * p_astar.get_point_weight_scale(p_path[i]);
+	}
+	return cost;
+}
+
+TEST_CASE("[AStar3D] Bidirectional search finds paths as short as forward search") {
+	const int N = 20;
+	Math::seed(0);
+
+	for (int test = 0; test < 200; test++) {
+		AStar3D a;
+		for (int u = 0; u < N; u++) {
+			a.add_point(u, Vector3(Math::rand() % 100, Math::rand() % 100, Math::rand() % 100), 1 + Math::rand() % 3);
+			a.set_point_disabled(u, Math::rand() % 10 == 0);
+		}
+		for (int i = 0; i < 3 * N; i++) {
+			int u = Math::rand() % N;
+			int v = Math::rand() % (N - 1);
+			if (u == v) {
+				v = N - 1;
+			}
+			a.connect_points(u, v, Math::rand() % 2);
+		}
+
+		for (int u = 0; u < N; u++) {
+			for (int v = 0; v < N; v++) {
+				a.set_bidirectional_search_enabled(false);
+				const Vector<int64_t> forward = a.get_id_path(u, v);
+				a.set_bidirectional_search_enabled(true);
+				const Vector<int64_t> bidirectional = a.get_id_path(u, v);
+
+				REQUIRE_MESSAGE(forward.is_empty() == bidirectional.is_empty(), vformat("Path from %d to %d.", u, v));
+				if (!forward.is_empty()) {
+					CHECK(bidirectional[0] == u);
+					CHECK(bidirectional[bidirectional.size() - 1] == v);
+					for (int i = 1; i < bidirectional.size(); i++) {
+						CHECK(a.are_points_connected(bidirectional[i - 1], bidirectional[i], false));
+						CHECK_FALSE(a.is_point_disabled(bidirectional[i]));
+					}
+					CHECK(Math::is_equal_approx(get_path_cost(a, forward), get_path_cost(a, bidirectional)));
+				}
+			}
+		}
+	}
+}
+
+struct ConcurrentPaths {
+	AStar3D *astar = nullptr;
+	LocalVector<Vector<int64_t>> paths;
+};
+
+static void find_concurrent_path(void *p_userdata, uint32_t p_index) {
+	ConcurrentPaths *concurrent = static_cast<ConcurrentPaths *>(p_userdata);
+	const int64_t point_count = concurrent->astar->get_point_count();
+	concurrent->paths[p_index] = concurrent->astar->get_id_path(p_index % point_count, (p_index * 7 + 3) % point_count);
+}
+
+TEST_CASE("[AStar3D] Concurrent queries") {
+	const int N = 200;
+	Math::seed(1);
+
+	AStar3D a;
+	for (int u = 0; u < N; u++) {
+		a.add_point(u, Vector3(Math::rand() % 100, Math::rand() % 100, Math::rand() % 100));
+	}
+	for (int i = 0; i < 4 * N; i++) {
+		int u = Math::rand() % N;
+		int v = Math::rand() % (N - 1);
+		if (u == v) {
+			v = N - 1;
+		}
+		a.connect_points(u, v);
+	}
+
+	for (int bidirectional = 0; bidirectional < 2; bidirectional++) {
+		a.set_bidirectional_search_enabled(bidirectional);
+
+		ConcurrentPaths concurrent;
+		concurrent.astar = &a;
+		concurrent.paths.resize(4 * N);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(find_concurrent_path, &concurrent, concurrent.paths.size());
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = 0; i < concurrent.paths.size(); i++) {
+			CHECK(concurrent.paths[i] == a.get_id_path(i % N, (i * 7 + 3) % N));
+		}
+	}
+}
+
 TEST_CASE("[AStar3D] Add/Remove") {
 	AStar3D a;
 
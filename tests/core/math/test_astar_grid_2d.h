@@ -0,0 +1,201 @@
+/**************************************************************************/
+/*  test_astar_grid_2d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ASTAR_GRID_2D_H
+#define TEST_ASTAR_GRID_2D_H
+
+#include "core/math/a_star_grid_2d.h"
+#include "core/os/os.h"
+#include "core/variant/typed_array.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAStarGrid2D {
+
+static int get_manhattan_length(const TypedArray<Vector2i> &p_path) {
+	int length = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		const Vector2i segment = Vector2i(p_path[i]) - Vector2i(p_path[i - 1]);
+		length += ABS(segment.x) + ABS(segment.y);
+	}
+	return length;
+}
+
+static void fill_random_solid_points(AStarGrid2D &r_astar, real_t p_density) {
+	const Rect2i region = r_astar.get_region();
+	for (int y = region.position.y; y < region.get_end().y; y++) {
+		for (int x = region.position.x; x < region.get_end().x; x++) {
+			r_astar.set_point_solid(Vector2i(x, y), Math::randf() < p_density);
+		}
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Path around a wall") {
+	AStarGrid2D a;
+	a.set_region(Rect2i(0, 0, 5, 5));
+	a.set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	a.update();
+	a.fill_solid_region(Rect2i(2, 0, 1, 4));
+
+	TypedArray<Vector2i> path = a.get_id_path(Vector2i(0, 0), Vector2i(4, 0));
+	REQUIRE(path.size() == 13);
+	CHECK(Vector2i(path[0]) == Vector2i(0, 0));
+	CHECK(Vector2i(path[6]) == Vector2i(2, 4));
+	CHECK(Vector2i(path[12]) == Vector2i(4, 0));
+
+	a.set_jumping_enabled(true);
+	path = a.get_id_path(Vector2i(0, 0), Vector2i(4, 0));
+	REQUIRE(path.size() < 13);
+	CHECK(Vector2i(path[path.size() - 1]) == Vector2i(4, 0));
+	CHECK(get_manhattan_length(path) == 12);
+
+	// Jumping has to notice that the wall changed.
+	a.set_point_solid(Vector2i(2, 0), false);
+	path = a.get_id_path(Vector2i(0, 0), Vector2i(4, 0));
+	CHECK(Vector2i(path[path.size() - 1]) == Vector2i(4, 0));
+	CHECK(get_manhattan_length(path) == 4);
+
+	a.set_jumping_enabled(false);
+	a.fill_solid_region(Rect2i(2, 0, 1, 5));
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(4, 0)).is_empty());
+	path = a.get_id_path(Vector2i(0, 0), Vector2i(4, 0), true);
+	REQUIRE_FALSE(path.is_empty());
+	CHECK(Vector2i(path[path.size() - 1]).x == 1);
+}
+
+TEST_CASE("[AStarGrid2D] Jumping finds the same points as walking") {
+	Math::seed(0);
+	const AStarGrid2D::DiagonalMode diagonal_modes[] = { AStarGrid2D::DIAGONAL_MODE_ALWAYS, AStarGrid2D::DIAGONAL_MODE_NEVER, AStarGrid2D::DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE, AStarGrid2D::DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES };
+
+	for (AStarGrid2D::DiagonalMode diagonal_mode : diagonal_modes) {
+		AStarGrid2D a;
+		a.set_region(Rect2i(-4, -4, 24, 24));
+		a.set_diagonal_mode(diagonal_mode);
+		a.update();
+
+		for (int test = 0; test < 20; test++) {
+			fill_random_solid_points(a, 0.3);
+			const Vector2i from = Vector2i(Math::rand() % 24 - 4, Math::rand() % 24 - 4);
+			const Vector2i to = Vector2i(Math::rand() % 24 - 4, Math::rand() % 24 - 4);
+			a.set_point_solid(from, false);
+			a.set_point_solid(to, false);
+
+			a.set_jumping_enabled(false);
+			const TypedArray<Vector2i> walked = a.get_id_path(from, to);
+			a.set_jumping_enabled(true);
+			const TypedArray<Vector2i> jumped = a.get_id_path(from, to);
+
+			CHECK_MESSAGE(walked.is_empty() == jumped.is_empty(), vformat("Path from %s to %s in diagonal mode %d.", from, to, diagonal_mode));
+			if (walked.is_empty() || jumped.is_empty()) {
+				continue;
+			}
+			CHECK(Vector2i(jumped[0]) == from);
+			CHECK(Vector2i(jumped[jumped.size() - 1]) == to);
+
+			// Every jump follows a straight or diagonal line of walkable points.
+			for (int i = 1; i < jumped.size(); i++) {
+				const Vector2i segment = Vector2i(jumped[i]) - Vector2i(jumped[i - 1]);
+				REQUIRE((segment.x == 0 || segment.y == 0 || ABS(segment.x) == ABS(segment.y)));
+				const Vector2i step = segment.sign();
+				for (Vector2i p = Vector2i(jumped[i - 1]) + step; p != Vector2i(jumped[i]); p += step) {
+					CHECK_FALSE(a.is_point_solid(p));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Batched paths match single paths") {
+	Math::seed(1);
+	AStarGrid2D a;
+	a.set_region(Rect2i(0, 0, 64, 64));
+	a.update();
+	fill_random_solid_points(a, 0.25);
+
+	for (int jumping = 0; jumping < 2; jumping++) {
+		a.set_jumping_enabled(jumping);
+
+		TypedArray<Vector2i> from_ids;
+		TypedArray<Vector2i> to_ids;
+		for (int i = 0; i < 64; i++) {
+			from_ids.push_back(Vector2i(Math::rand() % 64, Math::rand() % 64));
+			to_ids.push_back(Vector2i(Math::rand() % 64, Math::rand() % 64));
+		}
+
+		const Array paths = a.get_id_paths(from_ids, to_ids, true);
+		REQUIRE(paths.size() == 64);
+		for (int i = 0; i < paths.size(); i++) {
+			CHECK(paths[i] == Variant(a.get_id_path(from_ids[i], to_ids[i], true)));
+		}
+	}
+
+	ERR_PRINT_OFF;
+	CHECK(a.get_id_paths(TypedArray<Vector2i>(), TypedArray<Vector2i>()).is_empty());
+	TypedArray<Vector2i> single;
+	single.push_back(Vector2i());
+	CHECK(a.get_id_paths(single, TypedArray<Vector2i>()).is_empty());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Batched paths against single paths") {
+	Math::seed(2);
+	AStarGrid2D a;
+	a.set_region(Rect2i(0, 0, 256, 256));
+	a.update();
+	fill_random_solid_points(a, 0.2);
+
+	TypedArray<Vector2i> from_ids;
+	TypedArray<Vector2i> to_ids;
+	for (int i = 0; i < 500; i++) {
+		from_ids.push_back(Vector2i(Math::rand() % 256, Math::rand() % 256));
+		to_ids.push_back(Vector2i(Math::rand() % 256, Math::rand() % 256));
+	}
+
+	for (int jumping = 0; jumping < 2; jumping++) {
+		a.set_jumping_enabled(jumping);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		Array single_paths;
+		for (int i = 0; i < from_ids.size(); i++) {
+			single_paths.push_back(a.get_id_path(from_ids[i], to_ids[i]));
+		}
+		const uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		const Array batched_paths = a.get_id_paths(from_ids, to_ids);
+		const uint64_t batched_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_verbose(vformat("%d paths, jumping %s: get_id_path %d usec, get_id_paths %d usec.", from_ids.size(), jumping ? "enabled" : "disabled", single_usec, batched_usec));
+		CHECK(single_paths == batched_paths);
+	}
+}
+} // namespace TestAStarGrid2D
+
+#endif // TEST_ASTAR_GRID_2D_H
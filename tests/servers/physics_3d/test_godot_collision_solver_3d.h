@@ -0,0 +1,157 @@
+/**************************************************************************/
+/*  test_godot_collision_solver_3d.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_GODOT_COLLISION_SOLVER_3D_H
+#define TEST_GODOT_COLLISION_SOLVER_3D_H
+
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotCollisionSolver3D {
+
+struct ContactResult {
+	int count = 0;
+	real_t max_depth = 0.0;
+};
+
+static void _contact_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+	ContactResult *result = static_cast<ContactResult *>(p_userdata);
+	result->count++;
+	result->max_depth = MAX(result->max_depth, p_point_A.distance_to(p_point_B));
+}
+
+static Vector<Vector3> _box_points(const Vector3 &p_half_extents) {
+	Vector<Vector3> points;
+	for (int i = 0; i < 8; i++) {
+		points.push_back(Vector3((i & 1) ? p_half_extents.x : -p_half_extents.x, (i & 2) ? p_half_extents.y : -p_half_extents.y, (i & 4) ? p_half_extents.z : -p_half_extents.z));
+	}
+	return points;
+}
+
+TEST_CASE("[GodotCollisionSolver3D] Convex polygon range projection matches transformed vertices") {
+	GodotConvexPolygonShape3D *convex = memnew(GodotConvexPolygonShape3D);
+	Vector<Vector3> points = _box_points(Vector3(1.0, 2.0, 0.5));
+	points.push_back(Vector3(0.0, 3.0, 0.0));
+	points.push_back(Vector3(0.0, -3.0, 0.25));
+	convex->set_data(points);
+
+	const Transform3D transform(Basis(Vector3(1.0, 1.0, 0.0).normalized(), 0.7).scaled(Vector3(1.0, 2.0, 0.5)), Vector3(3.0, -1.0, 2.0));
+	const Vector3 normals[] = { Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1), Vector3(1, -2, 3).normalized(), Vector3(-0.3, 0.1, -1.0).normalized() };
+
+	for (const Vector3 &normal : normals) {
+		real_t expected_min = 1e20;
+		real_t expected_max = -1e20;
+		for (const Vector3 &point : points) {
+			real_t d = normal.dot(transform.xform(point));
+			expected_min = MIN(expected_min, d);
+			expected_max = MAX(expected_max, d);
+		}
+
+		real_t min = 0.0;
+		real_t max = 0.0;
+		convex->project_range(normal, transform, min, max);
+		CHECK(min == doctest::Approx(expected_min));
+		CHECK(max == doctest::Approx(expected_max));
+	}
+
+	memdelete(convex);
+}
+
+TEST_CASE("[GodotCollisionSolver3D] Box-box results match the generic convex polygon path") {
+	const Vector3 half_extents(1.0, 0.5, 2.0);
+	GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(half_extents);
+	GodotConvexPolygonShape3D *convex = memnew(GodotConvexPolygonShape3D);
+	convex->set_data(_box_points(half_extents));
+
+	const Transform3D transform_a(Basis(Vector3(0.0, 1.0, 0.0), 0.3), Vector3());
+	const Basis basis_b = Basis(Vector3(1.0, 0.0, 1.0).normalized(), 0.9);
+
+	for (int i = 0; i < 64; i++) {
+		const Vector3 origin_b = Vector3((i % 4) - 1.5, ((i / 4) % 4) - 1.5, (i / 16) - 1.5) * 1.3;
+		const Transform3D transform_b(basis_b, origin_b);
+
+		ContactResult box_result;
+		bool box_collided = GodotCollisionSolver3D::solve_static(box, transform_a, box, transform_b, _contact_callback, &box_result);
+		ContactResult convex_result;
+		bool convex_collided = GodotCollisionSolver3D::solve_static(box, transform_a, convex, transform_b, _contact_callback, &convex_result);
+
+		CHECK_MESSAGE(box_collided == convex_collided, vformat("Mismatch for box at %s.", origin_b));
+		CHECK((box_result.count > 0) == box_collided);
+	}
+
+	memdelete(convex);
+	memdelete(box);
+}
+
+TEST_CASE("[GodotCollisionSolver3D] Box-capsule collision") {
+	GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(Vector3(1.0, 1.0, 1.0));
+	GodotCapsuleShape3D *capsule = memnew(GodotCapsuleShape3D);
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.5;
+	capsule_data["height"] = 2.0;
+	capsule->set_data(capsule_data);
+
+	const Transform3D transform_box(Basis(Vector3(0.0, 0.0, 1.0), Math_PI / 4.0), Vector3());
+
+	SUBCASE("Capsule resting into the corner of a rotated box") {
+		ContactResult result;
+		// The rotated box reaches sqrt(2) on the Y axis, the capsule bottom sits 0.1 below it.
+		const Transform3D transform_capsule(Basis(), Vector3(0.0, Math_SQRT2 + 0.9, 0.0));
+		CHECK(GodotCollisionSolver3D::solve_static(box, transform_box, capsule, transform_capsule, _contact_callback, &result));
+		CHECK(result.count > 0);
+		CHECK(result.max_depth == doctest::Approx(0.1).epsilon(0.01));
+	}
+
+	SUBCASE("Separated capsule") {
+		ContactResult result;
+		const Transform3D transform_capsule(Basis(), Vector3(0.0, Math_SQRT2 + 1.1, 0.0));
+		CHECK_FALSE(GodotCollisionSolver3D::solve_static(box, transform_box, capsule, transform_capsule, _contact_callback, &result));
+		CHECK(result.count == 0);
+	}
+
+	SUBCASE("Capsule against the side of the box") {
+		ContactResult result;
+		const Transform3D transform_capsule(Basis(Vector3(0.0, 0.0, 1.0), Math_PI / 2.0), Vector3(0.0, 0.0, 1.4));
+		CHECK(GodotCollisionSolver3D::solve_static(box, transform_box, capsule, transform_capsule, _contact_callback, &result));
+		CHECK(result.max_depth == doctest::Approx(0.1).epsilon(0.01));
+	}
+
+	memdelete(capsule);
+	memdelete(box);
+}
+
+} // namespace TestGodotCollisionSolver3D
+
+#endif // TEST_GODOT_COLLISION_SOLVER_3D_H
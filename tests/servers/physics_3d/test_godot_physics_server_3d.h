@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  test_godot_physics_server_3d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_PHYSICS_SERVER_3D_H
+#define TEST_GODOT_PHYSICS_SERVER_3D_H
+
+#include "servers/physics_3d/godot_physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysicsServer3D {
+
+static RID _create_box_body(GodotPhysicsServer3D *p_server, RID p_space, RID p_shape, PhysicsServer3D::BodyMode p_mode, const Transform3D &p_transform) {
+	RID body = p_server->body_create();
+	p_server->body_set_mode(body, p_mode);
+	p_server->body_add_shape(body, p_shape);
+	p_server->body_set_space(body, p_space);
+	p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, p_transform);
+	return body;
+}
+
+TEST_CASE("[GodotPhysicsServer3D] Stacked boxes keep their contacts while resting") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+	// Half the default iterations, the stack relies on contacts and impulses carried across steps.
+	server->space_set_param(space, PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS, 8);
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(10.0, 0.5, 10.0));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	RID floor = _create_box_body(server, space, floor_shape, PhysicsServer3D::BODY_MODE_STATIC, Transform3D(Basis(), Vector3(0.0, -0.5, 0.0)));
+	RID boxes[3];
+	for (int i = 0; i < 3; i++) {
+		boxes[i] = _create_box_body(server, space, box_shape, PhysicsServer3D::BODY_MODE_RIGID, Transform3D(Basis(), Vector3(0.0, 0.5 + i, 0.0)));
+	}
+	server->body_set_max_contacts_reported(boxes[0], 4);
+
+	// Resting pairs skip the narrow phase on some steps, their contacts must be reported all the same.
+	bool always_in_contact = true;
+	for (int step = 0; step < 180; step++) {
+		server->step(1.0 / 60.0);
+		if (step >= 10 && server->body_get_direct_state(boxes[0])->get_contact_count() == 0) {
+			always_in_contact = false;
+		}
+	}
+	CHECK(always_in_contact);
+
+	for (int i = 0; i < 3; i++) {
+		const Transform3D transform = server->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(transform.origin.distance_to(Vector3(0.0, 0.5 + i, 0.0)) < 0.05, vformat("Box %d moved to %s.", i, transform.origin));
+		CHECK(bool(server->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_SLEEPING)));
+	}
+
+	for (int i = 0; i < 3; i++) {
+		server->free(boxes[i]);
+	}
+	server->free(floor);
+	server->free(box_shape);
+	server->free(floor_shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+}
+
+TEST_CASE("[GodotPhysicsServer3D] Space snapshots") {
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D);
+	server->init();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(10.0, 0.5, 10.0));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	RID floor = _create_box_body(server, space, floor_shape, PhysicsServer3D::BODY_MODE_STATIC, Transform3D(Basis(), Vector3(0.0, -0.5, 0.0)));
+	// A box sliding and spinning on the floor, so the snapshot holds contacts and their impulses.
+	RID box = _create_box_body(server, space, box_shape, PhysicsServer3D::BODY_MODE_RIGID, Transform3D(Basis(Vector3(0.0, 1.0, 0.0), 0.3), Vector3(0.0, 0.5, 0.0)));
+	server->body_set_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(2.0, 0.0, 0.5));
+	server->body_set_state(box, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0.0, 3.0, 0.0));
+
+	for (int step = 0; step < 10; step++) {
+		server->step(1.0 / 60.0);
+	}
+	const Vector<uint8_t> snapshot = server->space_save_snapshot(space);
+	REQUIRE_FALSE(snapshot.is_empty());
+
+	SUBCASE("Stepping again from a loaded snapshot should give the same results") {
+		const int steps = 30;
+		Transform3D transforms[steps];
+		Vector3 linear_velocities[steps];
+		Vector3 angular_velocities[steps];
+		for (int step = 0; step < steps; step++) {
+			server->step(1.0 / 60.0);
+			transforms[step] = server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+			linear_velocities[step] = server->body_get_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+			angular_velocities[step] = server->body_get_state(box, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+		}
+
+		REQUIRE(server->space_load_snapshot(space, snapshot));
+		for (int step = 0; step < steps; step++) {
+			server->step(1.0 / 60.0);
+			CHECK(Transform3D(server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM)) == transforms[step]);
+			CHECK(Vector3(server->body_get_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == linear_velocities[step]);
+			CHECK(Vector3(server->body_get_state(box, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY)) == angular_velocities[step]);
+		}
+	}
+
+	SUBCASE("Malformed snapshots should be rejected") {
+		Vector<uint8_t> truncated = snapshot;
+		truncated.resize(snapshot.size() - 1);
+		Vector<uint8_t> corrupted = snapshot;
+		corrupted.write[0] ^= 0xff;
+
+		ERR_PRINT_OFF;
+		CHECK_FALSE(server->space_load_snapshot(space, Vector<uint8_t>()));
+		CHECK_FALSE(server->space_load_snapshot(space, truncated));
+		CHECK_FALSE(server->space_load_snapshot(space, corrupted));
+		ERR_PRINT_ON;
+	}
+
+	server->free(box);
+	server->free(floor);
+	server->free(box_shape);
+	server->free(floor_shape);
+	server->free(space);
+	server->finish();
+	memdelete(server);
+}
+
+} // namespace TestGodotPhysicsServer3D
+
+#endif // TEST_GODOT_PHYSICS_SERVER_3D_H
@@ -0,0 +1,191 @@
+/**************************************************************************/
+/*  test_godot_shape_3d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_GODOT_SHAPE_3D_H
+#define TEST_GODOT_SHAPE_3D_H
+
+#include "servers/physics_3d/godot_shape_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotShape3D {
+
+struct CullResult {
+	AABB aabb;
+	int overlapping = 0;
+};
+
+static bool _cull_callback(void *p_userdata, GodotShape3D *p_convex) {
+	CullResult *result = static_cast<CullResult *>(p_userdata);
+	const GodotFaceShape3D *face = static_cast<GodotFaceShape3D *>(p_convex);
+	AABB face_aabb(face->vertex[0], Vector3());
+	face_aabb.expand_to(face->vertex[1]);
+	face_aabb.expand_to(face->vertex[2]);
+	if (result->aabb.intersects(face_aabb)) {
+		result->overlapping++;
+	}
+	return false;
+}
+
+static real_t _test_height(int p_x, int p_z) {
+	return Math::sin(p_x * 0.37) * 3.0 + Math::cos(p_z * 0.21) * 2.0;
+}
+
+static int _count_overlapping_faces(const Vector<Vector3> &p_faces, const AABB &p_aabb) {
+	int count = 0;
+	for (int i = 0; i < p_faces.size(); i += 3) {
+		if (p_aabb.intersects(Face3(p_faces[i], p_faces[i + 1], p_faces[i + 2]).get_aabb())) {
+			count++;
+		}
+	}
+	return count;
+}
+
+static Vector<Vector3> _grid_faces(int p_size) {
+	Vector<Vector3> faces;
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			const Vector3 p00(x, _test_height(x, z), z);
+			const Vector3 p10(x + 1, _test_height(x + 1, z), z);
+			const Vector3 p01(x, _test_height(x, z + 1), z + 1);
+			const Vector3 p11(x + 1, _test_height(x + 1, z + 1), z + 1);
+			faces.push_back(p00);
+			faces.push_back(p10);
+			faces.push_back(p01);
+			faces.push_back(p10);
+			faces.push_back(p11);
+			faces.push_back(p01);
+		}
+	}
+	return faces;
+}
+
+TEST_CASE("[GodotShape3D] Concave polygon queries match brute force") {
+	const Vector<Vector3> faces = _grid_faces(40);
+
+	GodotConcavePolygonShape3D *concave = memnew(GodotConcavePolygonShape3D);
+	Dictionary data;
+	data["faces"] = faces;
+	data["backface_collision"] = true;
+	concave->set_data(data);
+
+	// Shared vertices are only stored once, faces are returned unchanged.
+	CHECK(concave->vertices.size() == 41 * 41);
+	CHECK(concave->get_faces() == faces);
+
+	SUBCASE("Culling") {
+		for (int i = 0; i < 32; i++) {
+			const AABB aabb(Vector3((i * 7) % 37, (i % 5) - 3.0, (i * 11) % 37), Vector3(0.5 + (i % 4), 0.5 + (i % 3), 0.25 + (i % 6)));
+			CullResult result;
+			result.aabb = aabb;
+			concave->cull(aabb, _cull_callback, &result, false);
+			CHECK_MESSAGE(result.overlapping == _count_overlapping_faces(faces, aabb), vformat("Mismatch for %s.", aabb));
+		}
+	}
+
+	SUBCASE("Segment intersection") {
+		for (int i = 0; i < 32; i++) {
+			const Vector3 from((i * 7) % 37 + 0.3, 10.0, (i * 5) % 37 + 0.6);
+			const Vector3 to = from + Vector3((i % 3) - 1.0, -20.0, (i % 5) - 2.0);
+
+			real_t closest = 1e20;
+			Vector3 expected;
+			for (int j = 0; j < faces.size(); j += 3) {
+				Vector3 hit;
+				if (Face3(faces[j], faces[j + 1], faces[j + 2]).intersects_segment(from, to, &hit) && from.distance_to(hit) < closest) {
+					closest = from.distance_to(hit);
+					expected = hit;
+				}
+			}
+
+			Vector3 result;
+			Vector3 normal;
+			int face_index = -1;
+			CHECK(concave->intersect_segment(from, to, result, normal, face_index, true));
+			CHECK(result.is_equal_approx(expected));
+		}
+	}
+
+	memdelete(concave);
+}
+
+TEST_CASE("[GodotShape3D] Height map culling reports every overlapping face") {
+	const int size = 100;
+	Vector<real_t> heights;
+	real_t min_height = 1e20;
+	real_t max_height = -1e20;
+	for (int z = 0; z < size; z++) {
+		for (int x = 0; x < size; x++) {
+			const real_t height = _test_height(x, z);
+			heights.push_back(height);
+			min_height = MIN(min_height, height);
+			max_height = MAX(max_height, height);
+		}
+	}
+
+	GodotHeightMapShape3D *heightmap = memnew(GodotHeightMapShape3D);
+	Dictionary data;
+	data["width"] = size;
+	data["depth"] = size;
+	data["heights"] = heights;
+	data["min_height"] = min_height;
+	data["max_height"] = max_height;
+	heightmap->set_data(data);
+
+	// Same faces as the heightmap, in its local space.
+	Vector<Vector3> faces = _grid_faces(size - 1);
+	const Vector3 offset(0.5 * (size - 1), 0.0, 0.5 * (size - 1));
+	Vector3 *faces_w = faces.ptrw();
+	for (int i = 0; i < faces.size(); i++) {
+		faces_w[i] -= offset;
+	}
+
+	for (int i = 0; i < 32; i++) {
+		const AABB aabb(Vector3((i * 13) % 90, (i % 7) - 4.0, (i * 17) % 90) - offset, Vector3(0.5 + (i % 4) * 4.0, 0.5 + (i % 3), 0.5 + (i % 5) * 3.0));
+		CullResult result;
+		result.aabb = aabb;
+		heightmap->cull(aabb, _cull_callback, &result, false);
+		CHECK_MESSAGE(result.overlapping == _count_overlapping_faces(faces, aabb), vformat("Mismatch for %s.", aabb));
+	}
+
+	SUBCASE("Query above the terrain") {
+		CullResult result;
+		result.aabb = AABB(Vector3(-10.0, max_height + 1.0, -10.0), Vector3(20.0, 1.0, 20.0));
+		heightmap->cull(result.aabb, _cull_callback, &result, false);
+		CHECK(result.overlapping == 0);
+	}
+
+	memdelete(heightmap);
+}
+
+} // namespace TestGodotShape3D
+
+#endif // TEST_GODOT_SHAPE_3D_H
@@ -31,6 +31,8 @@
 #ifndef TEST_NAVIGATION_SERVER_2D_H
 #define TEST_NAVIGATION_SERVER_2D_H
 
+#include "scene/resources/2d/navigation_mesh_source_geometry_data_2d.h"
+#include "scene/resources/2d/navigation_polygon.h"
 #include "servers/navigation_server_2d.h"
 
 #include "tests/test_macros.h"
@@ -41,6 +43,44 @@ TEST_SUITE("[Navigation]") {
 		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
 		CHECK_EQ(navigation_server->get_maps().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer2D] Server should bake tiles and only rebake the changed ones") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+		Ref<NavigationPolygon> navigation_polygon = memnew(NavigationPolygon);
+		Ref<NavigationMeshSourceGeometryData2D> source_geometry = memnew(NavigationMeshSourceGeometryData2D);
+
+		Vector<Vector2> traversable_outline;
+		traversable_outline.push_back(Vector2(0.0, 0.0));
+		traversable_outline.push_back(Vector2(100.0, 0.0));
+		traversable_outline.push_back(Vector2(100.0, 100.0));
+		traversable_outline.push_back(Vector2(0.0, 100.0));
+		source_geometry->add_traversable_outline(traversable_outline);
+
+		Dictionary tiles = navigation_server->bake_tiles_from_source_geometry_data(navigation_polygon, source_geometry, 50.0);
+		CHECK_EQ(tiles.size(), 4);
+		REQUIRE(tiles.has(Vector2i(0, 0)));
+		REQUIRE(tiles.has(Vector2i(1, 1)));
+		CHECK_EQ(navigation_polygon->get_polygon_count(), 0);
+		Ref<NavigationPolygon> first_tile = tiles[Vector2i(0, 0)];
+		CHECK_GT(first_tile->get_polygon_count(), 0);
+		CHECK_EQ(first_tile->get_outline_count(), 0);
+
+		Dictionary rebaked_tiles = navigation_server->bake_tiles_from_source_geometry_data(navigation_polygon, source_geometry, 50.0);
+		CHECK_EQ(rebaked_tiles.size(), 4);
+		CHECK_EQ(Ref<NavigationPolygon>(rebaked_tiles[Vector2i(1, 1)]), Ref<NavigationPolygon>(tiles[Vector2i(1, 1)]));
+
+		Vector<Vector2> obstruction_outline;
+		obstruction_outline.push_back(Vector2(80.0, 80.0));
+		obstruction_outline.push_back(Vector2(90.0, 80.0));
+		obstruction_outline.push_back(Vector2(90.0, 90.0));
+		obstruction_outline.push_back(Vector2(80.0, 90.0));
+		source_geometry->add_obstruction_outline(obstruction_outline);
+
+		rebaked_tiles = navigation_server->bake_tiles_from_source_geometry_data(navigation_polygon, source_geometry, 50.0);
+		CHECK_EQ(rebaked_tiles.size(), 4);
+		CHECK_EQ(Ref<NavigationPolygon>(rebaked_tiles[Vector2i(0, 0)]), first_tile);
+		CHECK_NE(Ref<NavigationPolygon>(rebaked_tiles[Vector2i(1, 1)]), Ref<NavigationPolygon>(tiles[Vector2i(1, 1)]));
+	}
 }
 } //namespace TestNavigationServer2D
 
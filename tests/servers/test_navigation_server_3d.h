@@ -61,6 +61,52 @@ static inline Array build_array(Variant item, Targs... Fargs) {
 	return a;
 }
 
+// Navigation mesh made of `p_grid_size` x `p_grid_size` unit quads, starting at the origin.
+static Ref<NavigationMesh> build_grid_navigation_mesh(int p_grid_size) {
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_grid_size; z++) {
+		for (int x = 0; x <= p_grid_size; x++) {
+			vertices.push_back(Vector3(x, 0.0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < p_grid_size; z++) {
+		for (int x = 0; x < p_grid_size; x++) {
+			const int corner = z * (p_grid_size + 1) + x;
+			Vector<int> polygon;
+			polygon.push_back(corner);
+			polygon.push_back(corner + 1);
+			polygon.push_back(corner + p_grid_size + 2);
+			polygon.push_back(corner + p_grid_size + 1);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+// Regions of 8x8 unit quads laid out in a 4x4 grid on `p_map`, without the four middle ones.
+// Regions are returned row by row, starting at the origin.
+static LocalVector<RID> create_regions_around_hole(RID p_map) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	const int grid_size = 8;
+	Ref<NavigationMesh> navigation_mesh = build_grid_navigation_mesh(grid_size);
+	LocalVector<RID> regions;
+	for (int region_z = 0; region_z < 4; region_z++) {
+		for (int region_x = 0; region_x < 4; region_x++) {
+			if ((region_x == 1 || region_x == 2) && (region_z == 1 || region_z == 2)) {
+				continue;
+			}
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, p_map);
+			navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(region_x * grid_size, 0.0, region_z * grid_size)));
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			regions.push_back(region);
+		}
+	}
+	return regions;
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -749,6 +795,33 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same paths as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			for (int i = 0; i < 8; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(i, 0, 0));
+				query_parameters->set_target_position(Vector3(10, 0, 10 - i));
+				batch_parameters.push_back(query_parameters);
+			}
+
+			CallableMock query_paths_callback_mock;
+			navigation_server->query_paths(batch_parameters, callable_mp(&query_paths_callback_mock, &CallableMock::function1));
+			CHECK_EQ(query_paths_callback_mock.function1_calls, 1);
+			const Array batch_results = query_paths_callback_mock.function1_latest_arg0;
+			REQUIRE_EQ(batch_results.size(), batch_parameters.size());
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(batch_parameters[i], query_result);
+				const Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				REQUIRE(batch_result.is_valid());
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK(batch_result->get_path() == query_result->get_path());
+				CHECK_EQ(batch_result->get_path_rids().size(), query_result->get_path_rids().size());
+			}
+		}
+
 		SUBCASE("Elaborate query without metadata flags should yield path only") {
 			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
 			query_parameters->set_map(map);
@@ -768,6 +841,271 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Map queries should find the closest polygons of a large map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Grid of 64x64 unit quads, so queries have to pick among many polygons.
+		Ref<NavigationMesh> navigation_mesh = build_grid_navigation_mesh(64);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_cell_size(map, 0.25);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(10.3, 2.0, 40.7)).is_equal_approx(Vector3(10.3, 0.0, 40.7)));
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(-3.0, 1.0, 20.5)).is_equal_approx(Vector3(0.0, 0.0, 20.5)));
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(70.0, -1.0, 70.0)).is_equal_approx(Vector3(64.0, 0.0, 64.0)));
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(33.5, 1.0, 12.5)), region);
+		CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(5.5, 1.0, 5.5), Vector3(5.5, -1.0, 5.5), true).is_equal_approx(Vector3(5.5, 0.0, 5.5)));
+		CHECK(navigation_server->map_get_closest_point_to_segment(map, Vector3(-5.0, 2.0, 30.0), Vector3(-2.0, 1.0, 30.0), false).is_equal_approx(Vector3(0.0, 0.0, 30.0)));
+
+		const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0.5, 1.0, 0.5), Vector3(60.5, 1.0, 50.5), true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[0].is_equal_approx(Vector3(0.5, 0.0, 0.5)));
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(60.5, 0.0, 50.5)));
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Map synchronization should connect the border edges of regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Grid of 8x8 unit quads, used by three regions side by side.
+		const int grid_size = 8;
+		Ref<NavigationMesh> navigation_mesh = build_grid_navigation_mesh(grid_size);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_cell_size(map, 0.25);
+		navigation_server->map_set_edge_connection_margin(map, 0.5);
+		RID regions[3];
+		for (int i = 0; i < 3; i++) {
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_navigation_mesh(regions[i], navigation_mesh);
+		}
+		// The first two regions share their border, the third one is slightly apart.
+		navigation_server->region_set_transform(regions[1], Transform3D(Basis(), Vector3(grid_size, 0.0, 0.0)));
+		navigation_server->region_set_transform(regions[2], Transform3D(Basis(), Vector3(grid_size * 2 + 0.3, 0.0, 0.0)));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->region_get_connections_count(regions[0]), 0);
+		CHECK_GT(navigation_server->region_get_connections_count(regions[1]), 0);
+		CHECK_GT(navigation_server->region_get_connections_count(regions[2]), 0);
+
+		Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0.5, 0.0, 4.5), Vector3(23.5, 0.0, 4.5), true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(23.5, 0.0, 4.5)));
+
+		// Moving the third region away disconnects it, and only the reachable part of the path remains.
+		navigation_server->region_set_transform(regions[2], Transform3D(Basis(), Vector3(grid_size * 2 + 1.0, 0.0, 0.0)));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->region_get_connections_count(regions[1]), 0);
+		CHECK_EQ(navigation_server->region_get_connections_count(regions[2]), 0);
+		path = navigation_server->map_get_path(map, Vector3(0.5, 0.0, 4.5), Vector3(24.5, 0.0, 4.5), true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(16.0, 0.0, 4.5)));
+
+		for (int i = 0; i < 3; i++) {
+			navigation_server->free(regions[i]);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Hierarchical path queries should find paths close to the ones of flat queries") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// The middle regions are missing, so paths have to go around.
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_cell_size(map, 0.25);
+		const LocalVector<RID> regions = create_regions_around_hole(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start_positions[] = { Vector3(0.5, 0.0, 0.5), Vector3(12.5, 0.0, 3.5), Vector3(2.5, 0.0, 29.5) };
+		const Vector3 target_positions[] = { Vector3(31.5, 0.0, 31.5), Vector3(20.5, 0.0, 28.5), Vector3(30.5, 0.0, 1.5) };
+		for (int i = 0; i < 3; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(start_positions[i]);
+			query_parameters->set_target_position(target_positions[i]);
+
+			Ref<NavigationPathQueryResult3D> flat_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path(query_parameters, flat_result);
+			query_parameters->set_pathfinding_algorithm(NavigationPathQueryParameters3D::PATHFINDING_ALGORITHM_HIERARCHICAL_ASTAR);
+			Ref<NavigationPathQueryResult3D> hierarchical_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path(query_parameters, hierarchical_result);
+
+			const Vector<Vector3> flat_path = flat_result->get_path();
+			const Vector<Vector3> hierarchical_path = hierarchical_result->get_path();
+			REQUIRE_GE(flat_path.size(), 2);
+			REQUIRE_GE(hierarchical_path.size(), 2);
+			CHECK(hierarchical_path[0].is_equal_approx(flat_path[0]));
+			CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(flat_path[flat_path.size() - 1]));
+
+			real_t flat_length = 0.0;
+			for (int j = 1; j < flat_path.size(); j++) {
+				flat_length += flat_path[j - 1].distance_to(flat_path[j]);
+			}
+			real_t hierarchical_length = 0.0;
+			for (int j = 1; j < hierarchical_path.size(); j++) {
+				hierarchical_length += hierarchical_path[j - 1].distance_to(hierarchical_path[j]);
+			}
+			// The route between the regions is chosen on estimated costs, so it may not be the shortest one.
+			CHECK_LE(hierarchical_length, flat_length * 1.1);
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Flow directions should lead agents to their targets") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// The middle regions are missing, so agents have to go around.
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_cell_size(map, 0.25);
+		const LocalVector<RID> regions = create_regions_around_hole(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		Vector<Vector3> targets;
+		targets.push_back(Vector3(20.5, 0.0, 28.5));
+
+		SUBCASE("Following the flow directions should reach the target") {
+			const Vector3 start_positions[] = { Vector3(12.5, 0.0, 3.5), Vector3(0.5, 0.0, 0.5), Vector3(30.5, 0.0, 12.5) };
+			for (const Vector3 &start_position : start_positions) {
+				Vector3 position = start_position;
+				for (int step = 0; step < 400 && position.distance_to(targets[0]) > 0.5; step++) {
+					const Vector3 direction = navigation_server->map_get_flow_direction(map, targets, position);
+					REQUIRE(direction.is_normalized());
+					position += direction * MIN((real_t)0.25, position.distance_to(targets[0]));
+					// Never leave the navigation mesh through the missing middle regions.
+					CHECK_FALSE((position.x > 8.0 + CMP_EPSILON && position.x < 24.0 - CMP_EPSILON && position.z > 8.0 + CMP_EPSILON && position.z < 24.0 - CMP_EPSILON));
+				}
+				CHECK_LE(position.distance_to(targets[0]), 0.5);
+			}
+		}
+
+		SUBCASE("Positions in the target polygon should head to the target directly") {
+			const Vector3 direction = navigation_server->map_get_flow_direction(map, targets, Vector3(20.1, 0.0, 28.5));
+			CHECK(direction.is_equal_approx(Vector3(1.0, 0.0, 0.0)));
+		}
+
+		SUBCASE("The closest of several targets should be reached") {
+			targets.push_back(Vector3(3.5, 0.0, 3.5));
+			const Vector3 direction = navigation_server->map_get_flow_direction(map, targets, Vector3(0.5, 0.0, 3.5));
+			CHECK_GT(direction.x, 0.9);
+		}
+
+		SUBCASE("Changing the travel costs of regions should update the flow directions") {
+			targets.write[0] = Vector3(28.5, 0.0, 12.5);
+			// Follows the flow from the left column of regions to the right one, returning the lowest z passed.
+			const auto follow_flow = [&]() {
+				Vector3 position = Vector3(4.5, 0.0, 12.5);
+				real_t min_z = position.z;
+				for (int step = 0; step < 400 && position.distance_to(targets[0]) > 0.5; step++) {
+					const Vector3 direction = navigation_server->map_get_flow_direction(map, targets, position);
+					position += direction * MIN((real_t)0.25, position.distance_to(targets[0]));
+					min_z = MIN(min_z, position.z);
+				}
+				CHECK_LE(position.distance_to(targets[0]), 0.5);
+				return min_z;
+			};
+
+			// Going around the top of the missing middle regions is shorter.
+			CHECK_LT(follow_flow(), 8.0);
+
+			// Once the top middle regions are expensive, the cached flow field must not be used anymore.
+			navigation_server->region_set_travel_cost(regions[1], 10.0);
+			navigation_server->region_set_travel_cost(regions[2], 10.0);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_GT(follow_flow(), 8.0);
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should bake tiles and only rebake the changed ones") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(24.0, 0.001, 24.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+
+		// The plane spans from -12 to 12, so it overlaps 4x4 tiles of size 8.
+		Dictionary tiles = navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, source_geometry, 8.0);
+		CHECK_EQ(tiles.size(), 16);
+		REQUIRE(tiles.has(Vector2i(-2, -2)));
+		REQUIRE(tiles.has(Vector2i(1, 1)));
+		CHECK_EQ(navigation_mesh->get_polygon_count(), 0);
+		Ref<NavigationMesh> corner_tile = tiles[Vector2i(-2, -2)];
+		CHECK_GT(corner_tile->get_polygon_count(), 0);
+
+		SUBCASE("Baking unchanged source geometry should return the cached tiles") {
+			Dictionary rebaked_tiles = navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, source_geometry, 8.0);
+			CHECK_EQ(rebaked_tiles.size(), 16);
+			const Array coordinates = tiles.keys();
+			for (int i = 0; i < coordinates.size(); i++) {
+				CHECK_EQ(Ref<NavigationMesh>(rebaked_tiles[coordinates[i]]), Ref<NavigationMesh>(tiles[coordinates[i]]));
+			}
+		}
+
+		SUBCASE("Baking changed source geometry should only rebake the changed tiles") {
+			Array box_arr;
+			box_arr.resize(RS::ARRAY_MAX);
+			BoxMesh::create_mesh_array(box_arr, Vector3(2.0, 2.0, 2.0));
+			source_geometry->add_mesh_array(box_arr, Transform3D(Basis(), Vector3(10.0, 1.0, 10.0)));
+
+			Dictionary rebaked_tiles = navigation_server->bake_tiles_from_source_geometry_data(navigation_mesh, source_geometry, 8.0);
+			CHECK_EQ(rebaked_tiles.size(), 16);
+			CHECK_EQ(Ref<NavigationMesh>(rebaked_tiles[Vector2i(-2, -2)]), corner_tile);
+			CHECK_NE(Ref<NavigationMesh>(rebaked_tiles[Vector2i(1, 1)]), Ref<NavigationMesh>(tiles[Vector2i(1, 1)]));
+		}
+
+		SUBCASE("Tiles assigned to their own regions should be connected by the map") {
+			RID map = navigation_server->map_create();
+			navigation_server->map_set_active(map, true);
+			LocalVector<RID> regions;
+			const Array coordinates = tiles.keys();
+			for (int i = 0; i < coordinates.size(); i++) {
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, map);
+				navigation_server->region_set_navigation_mesh(region, tiles[coordinates[i]]);
+				regions.push_back(region);
+			}
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			const Vector3 target_position = Vector3(10.0, 0.0, 10.0);
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-10.0, 0.0, -10.0), target_position, true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK_LT(path[path.size() - 1].distance_to(target_position), 1.0);
+
+			for (const RID &region : regions) {
+				navigation_server->free(region);
+			}
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
@@ -54,6 +54,7 @@
 #include "tests/core/io/test_xml_parser.h"
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
+#include "tests/core/math/test_astar_grid_2d.h"
 #include "tests/core/math/test_basis.h"
 #include "tests/core/math/test_color.h"
 #include "tests/core/math/test_expression.h"
@@ -152,6 +153,9 @@
 #include "tests/scene/test_path_3d.h"
 #include "tests/scene/test_path_follow_3d.h"
 #include "tests/scene/test_primitives.h"
+#include "tests/servers/physics_3d/test_godot_collision_solver_3d.h"
+#include "tests/servers/physics_3d/test_godot_physics_server_3d.h"
+#include "tests/servers/physics_3d/test_godot_shape_3d.h"
 #endif // _3D_DISABLED
 
 #include "modules/modules_tests.gen.h"